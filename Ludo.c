@@ -5,10 +5,16 @@
 #include <ctype.h>
 #include <signal.h>
 #include <math.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <stdatomic.h>
 
 /* OS Detection to make sure screen clearing, sleep, and curses function works */
 #if defined(__linux__) || defined(unix)
 #include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 
 // Ncurses for Linux user
 #include <ncurses.h>
@@ -16,6 +22,7 @@ char *os = "linux";
 #else
 #ifdef _WIN32
 #include <windows.h>
+#include <malloc.h>
 
 // PDCurses (port of ncurses) for windows user
 #include "PDCurses/curses.h"
@@ -23,12 +30,18 @@ char *os = "windows";
 #else
 #ifdef __APPLE__
 #include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 
 // Ncurses for the macs as well
 #include <ncurses.h>
 char *os = "macos";
 #else
 #include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 #include <ncurses.h>
 char *os = "unknown";
 #endif
@@ -68,58 +81,749 @@ typedef struct
     int score;
 } Score;
 
-WINDOW *board[15][15]; // Ludo board (graphically)
+/*
+    Random number stream (SplitMix64), every game has its own stream so games
+    can be played in parallel without sharing rand(), and the same seed
+    always gives the same dice rolls and suits
+*/
+typedef struct
+{
+    uint64_t state;
+} Random;
+
+/*
+    Packed state of one game in 16 bytes, one byte per token in the order of
+    the player array (red, green, yellow, blue) then the index of the token.
+    Bits 0 - 5 are the progress of the token from its home base :
+    0       -> in the home base
+    1 - 51  -> on the board, the same as relpos
+    52 - 57 -> in the safezone, 51 + pos (57 is finished)
+    Bit 6 is set if the colour of the token is playing, bit 7 is set if it's
+    the turn of the colour of the token
+*/
+typedef struct
+{
+    uint8_t token[16];
+} PackedGame;
+
+/*
+    Board geometry of one colour, the cells of the tokens are in tokenCell
+*/
+typedef struct
+{
+    char col;          // Color of the player
+    int start;         // Board position when the token is out of home base
+    int safezoneEntry; // Last board position before entering the safezone
+    int pair;          // Colour pair of the tokens on the board
+} ColourGeometry;
+
+/*
+    Geometry of every colour, sorted the same as the player array
+*/
+const ColourGeometry colourGeometry[4] = {
+    {'r', 1, 51, BOARD_RED},
+    {'g', 14, 12, BOARD_GREEN},
+    {'y', 27, 25, BOARD_YELLOW},
+    {'b', 40, 38, BOARD_BLUE},
+};
+
+/*
+    Coordinate of one cell in the board, x is the row and y is the collumn
+*/
+typedef struct
+{
+    unsigned char x;
+    unsigned char y;
+} BoardCell;
+
+// Cells of the board positions 1 - 52, index 0 is not used
+#define RING_CELLS \
+    {0, 0}, {1, 8}, {2, 8}, {3, 8}, {4, 8}, {5, 8}, {6, 9}, {6, 10}, \
+    {6, 11}, {6, 12}, {6, 13}, {6, 14}, {7, 14}, {8, 14}, {8, 13}, {8, 12}, \
+    {8, 11}, {8, 10}, {8, 9}, {9, 8}, {10, 8}, {11, 8}, {12, 8}, {13, 8}, \
+    {14, 8}, {14, 7}, {14, 6}, {13, 6}, {12, 6}, {11, 6}, {10, 6}, {9, 6}, \
+    {8, 5}, {8, 4}, {8, 3}, {8, 2}, {8, 1}, {8, 0}, {7, 0}, {6, 0}, \
+    {6, 1}, {6, 2}, {6, 3}, {6, 4}, {6, 5}, {5, 6}, {4, 6}, {3, 6}, \
+    {2, 6}, {1, 6}, {0, 6}, {0, 7}, {0, 8}
+
+/*
+    Cell of every token position, indexed by the colour, the safe flag and the
+    position of the token. The safezone is a straight line towards the center
+    of the board, position 6 is the finished token
+*/
+const BoardCell tokenCell[4][2][53] = {
+    // Red
+    {{RING_CELLS}, {{0, 7}, {1, 7}, {2, 7}, {3, 7}, {4, 7}, {5, 7}, {6, 7}}},
+    // Green
+    {{RING_CELLS}, {{7, 14}, {7, 13}, {7, 12}, {7, 11}, {7, 10}, {7, 9}, {7, 8}}},
+    // Yellow
+    {{RING_CELLS}, {{14, 7}, {13, 7}, {12, 7}, {11, 7}, {10, 7}, {9, 7}, {8, 7}}},
+    // Blue
+    {{RING_CELLS}, {{7, 0}, {7, 1}, {7, 2}, {7, 3}, {7, 4}, {7, 5}, {7, 6}}},
+};
+
+/*
+    What is drawn on one cell of the board
+*/
+typedef struct
+{
+    int pair;      // Colour pair of the cell
+    char shown[9]; // Tokens shown in the cell, one character each
+} CellFrame;
+
+/*
+    Rectangle of one cell in the board window
+*/
+typedef struct
+{
+    int row;    // Top row in the board window
+    int col;    // Leftmost collumn in the board window
+    int width;  // 0 if the cell is merged into the cell on its left
+} CellRect;
+
+/*
+    Cells of the home base of every colour, filled in order by the tokens that
+    are still in the home base
+*/
+const BoardCell homeCell[4][4] = {
+    {{2, 11}, {2, 12}, {3, 11}, {3, 12}},
+    {{11, 11}, {11, 12}, {12, 11}, {12, 12}},
+    {{11, 2}, {11, 3}, {12, 2}, {12, 3}},
+    {{2, 2}, {2, 3}, {3, 2}, {3, 3}},
+};
+
+/*
+    All of the state of one game, every rules function takes it explicitly
+    so many games can live in one process
+*/
+typedef struct
+{
+    /*
+        Player array consist of all of the player
+        The array is sorted according to colour
+        red -> index 0
+        green -> index 1
+        yellow -> index 2
+        blue -> index 3
+    */
+    Player players[4]; // List of players
+
+    /*
+        Array containing the player indexes in the player array
+    */
+    int playerIndex[4];
+
+    /*
+        Token arrays for each colours, indexed with the same colour order as
+        the player array
+
+        char col value per colour :
+        Red -> r
+        Green -> g
+        Yellow -> y
+        Blue -> b
+    */
+    Tokens tokens[4][4];
+
+    int numberOfBots; // Number of bots
+    int whosTurn;     // Who's take the turn
+    int count;        // Count how many turn that already done
+    int position;     // Rank in the game
+
+    /*
+        Occupancy index of the 52 board positions (index 0 is not used),
+        each bit is one token, bit colour * 4 + token index with the same
+        colour order as the player array. Tokens in the home base or in the
+        safezone are not in the index
+    */
+    uint16_t occupant[53];
+
+    /*
+        Bitboards of the same tokens, per colour. Bit pos - 1 of ring is set if
+        the colour has a token on the board position, bit pos - 1 of lane is set
+        if the colour has a token on the safezone position (1 - 6)
+    */
+    uint64_t ring[4];
+    uint8_t lane[4];
+
+    /*
+        Zobrist hash of the tokens and the colour of the current player, kept
+        up to date by every function that moves a token or changes the turn
+    */
+    uint64_t hash;
+
+    Random rng; // Random stream for the dice and the suits of the bots
+} GameContext;
+
+/*
+    One legal move of a token, as written by generateMoves
+*/
+typedef struct
+{
+    int8_t token;       // Index of the token of the current player
+    char action;        // 'o' to get out of the home base or 'm' to move, as in possibleMove
+    int8_t destination; // Board position (1 - 52), or safezone position (1 - 6) if safe
+    bool safe;          // The destination is in the safezone
+    bool isCapture;     // There's opponents on the destination, a suit has to be played
+} Move;
+
+WINDOW *board;         // Ludo board (graphically), every cell is 2 rows and 4 collumns
+CellRect cellRect[15][15]; // Position of every cell in the board window
 WINDOW *options;       // The box mmenu below of the board for the player to choose many things
 
+// The board as it's on the screen, only the cells that are different are redrawn
+CellFrame shownFrame[15][15];
+
+// The game that's played on the screen
+GameContext currentGame = {.whosTurn = 1, .count = 0, .position = 1};
+
+// Number of rows of every cell in the board window
+#define CELL_HEIGHT 2
+
+// Animation speed of the game
+#define SPEED_INSTANT 0
+#define SPEED_FAST 1
+#define SPEED_NORMAL 2
+
+// Events of the game that are followed by a wait
+#define PACE_TURN 0      // Turn banner
+#define PACE_MOVE 1      // Token enter the board or move on the board
+#define PACE_SUIT 2      // A suit round between two bots
+#define PACE_RESULT 3    // Result of a suit
+#define PACE_SAFEZONE 4  // Token move to the safezone
+#define NUMBER_OF_PACE 5
+
+// Wait of every event in milliseconds for each speed
+const int paceDelay[3][NUMBER_OF_PACE] = {
+    {0, 0, 0, 0, 0},
+    {300, 150, 150, 300, 300},
+    {1000, 1000, 1000, 1000, 1000},
+};
+
+// Name of the events as used in the command line
+const char *paceName[NUMBER_OF_PACE] = {"turn", "move", "suit", "result", "safezone"};
+
+int animationSpeed = SPEED_NORMAL;
+
+// Wait of the events in milliseconds set by the user, -1 if not set
+int paceOverride[NUMBER_OF_PACE] = {-1, -1, -1, -1, -1};
+
+// Maximum length of one line of the bot turn summary, as wide as the option box
+#define SUMMARY_LENGTH 57
+
+// Bot turns are played without drawing, then summarized before the human turn
+bool isFastForward = false;
+
+char turnSummary[3][SUMMARY_LENGTH]; // One line for every fast forwarded bot turn
+int numberOfSummary = 0;             // Number of bot turns that are not shown yet
+
+// Events of a replay log, every event is one byte with the type in the two
+// high bits and the value in the others
+#define REPLAY_DICE 0  // Dice roll (1 - 6)
+#define REPLAY_TOKEN 1 // Token that's moved (0 - 3)
+#define REPLAY_SUIT 2  // One suit choice (1 - 3), the player that take turn first
+#define REPLAY_TURN 3  // End of the turn
+#define REPLAY_MAGIC "LUDOREP"
+#define REPLAY_INDEX_MAGIC "LUDOIDX"
+
+// Turns between two keyframes of a replay log
+#define REPLAY_KEYFRAME_INTERVAL 16
+
+char *recordName = NULL;  // Replay log of the game is written to this file if it's set
+FILE *recordFile = NULL;  // Replay log that's being written
+long recordedEvents = 0;  // Number of events written to the replay log
+int recordedTurns = 0;    // Number of turns written to the replay log
+char *replayName = NULL;  // Replay log that's played instead of a game
+bool isWatching = false;  // The replay is shown on the board instead of at full speed
+bool isViewing = false;   // The replay is shown one turn at a time, going back and forth
+
+// Headless game is stopped after this many turns in case it never finished
+#define MAX_HEADLESS_TURN 100000
+
+// Archive of self-play games, every move of a turn is bit-packed as its dice
+// roll, the token that's moved and the outcome of the suit if there's any
+#define ARCHIVE_MAGIC "LUDOARC"
+#define ARCHIVE_CHUNK_MAGIC "LCK"
+#define ARCHIVE_DICE_BITS 3
+#define ARCHIVE_TOKEN_BITS 2
+#define ARCHIVE_SUIT_BITS 1
+
+// A chunk is written once its records are at least this many bytes
+#define ARCHIVE_CHUNK_SIZE 65536
+
+// Bytes of the longest game, a turn has at most 3 moves
+#define ARCHIVE_GAME_SIZE ((MAX_HEADLESS_TURN * 3 * (ARCHIVE_DICE_BITS + ARCHIVE_TOKEN_BITS + ARCHIVE_SUIT_BITS) + 7) / 8)
+
+// Bytes of the longest record, the game after two varints of at most 5 bytes
+#define ARCHIVE_RECORD_SIZE (ARCHIVE_GAME_SIZE + 10)
+
+// Replay events of the longest game, a turn has at most 3 dice, 3 tokens, 3 suits of 2 choices and its end
+#define ARCHIVE_EVENTS_SIZE (MAX_HEADLESS_TURN * 13)
+
+// Fields of a token in PackedGame
+#define PACKED_PROGRESS 0x3F
+#define PACKED_PLAYING 0x40
+#define PACKED_TURN 0x80
+
+// Progress of a token before it enters the safezone
+#define SAFEZONE_PROGRESS 51
+
+// Every board position as bits of the ring bitboard
+#define RING_MASK ((1ULL << 52) - 1)
+
+// Maximum number of threads used in a tournament
+#define MAX_THREAD 64
+
+// Size of a cache line, counters written by many threads are kept on their own
+#define CACHE_LINE 64
+
+// Number of bot types, 0 for Jörgen, 1 for Hans, 2 for Müller, 3 for Klaus, 4 for Franz, and 5 for Werner
+#define NUMBER_OF_BOT_TYPES 6
+
+// Score distribution of a simulation, SCORE_BUCKETS buckets of SCORE_BUCKET
+// points from LOWEST_SCORE, the scores outside are put in the first or last bucket
+#define SCORE_BUCKETS 50
+#define SCORE_BUCKET 50
+#define LOWEST_SCORE -250
+
+// Result format of a tournament, the table is for reading and the others for scripts
+#define OUTPUT_TABLE 0
+#define OUTPUT_CSV 1
+#define OUTPUT_JSON 2
+
+// Number of entries in the transposition table of Klaus, must be a power of two
+#define SEARCH_TABLE_SIZE (1 << 16)
+
+// Time budget of one move of Klaus, Franz and Werner in milliseconds, 0 means no limit
+int searchBudget = 100;
+
+// Most playouts of one move of Franz and Werner, 0 means no limit
+int playoutLimit = 2000;
+
+// Threads of one move of Werner, 0 for every hardware thread
+int playoutThreads = 0;
+
+// Werner gives every thread its own statistic and merges them at the end,
+// instead of every thread sharing one statistic
+bool isRootParallel = false;
+
+// Playout is decided as a race after this many rounds of every player
+#define PLAYOUT_ROUNDS 25
+
+// Progress a token in the home base is counted as behind the start, for the race without the tablebase
+#define PLAYOUT_HOME_PROGRESS 10
+
+// Progress of a finished token
+#define FINISHED_PROGRESS 57
+
+// Random keys of the Zobrist hash, the same on every run as they're filled from a fixed seed
+uint64_t zobristToken[4][4][FINISHED_PROGRESS + 1]; // Colour, token and progress (the safe flag is part of the progress)
+uint64_t zobristTurn[4];                            // Colour of the current player
+uint64_t zobristSixes[3];                           // Number of six already rolled in the turn
+
+// Farthest an opponent can come in one turn, three moves of six
+#define CAPTURE_DISTANCE 18
+
+/*
+    Chance that the only opponent token of a colour that can come, d positions
+    behind a token, captures it in its turn, indexed by d (1 - CAPTURE_DISTANCE).
+    A six moves a token and rolls again, the third six still moves but isn't
+    rolled again, so a token 7 to 12 behind has to roll a six first and 13 to 18
+    behind two sixes. The row is the number of sixes the other tokens of the
+    colour can be moved with (at most 2), a token up to 5 behind can let them
+    take a six and wait for the next roll
+*/
+const double captureChance[3][CAPTURE_DISTANCE + 1] = {
+    {0,
+     1.0 / 6, 1.0 / 6, 1.0 / 6, 1.0 / 6, 1.0 / 6, 1.0 / 6,
+     1.0 / 36, 1.0 / 36, 1.0 / 36, 1.0 / 36, 1.0 / 36, 1.0 / 36,
+     1.0 / 216, 1.0 / 216, 1.0 / 216, 1.0 / 216, 1.0 / 216, 1.0 / 216},
+    {0,
+     7.0 / 36, 7.0 / 36, 7.0 / 36, 7.0 / 36, 7.0 / 36, 1.0 / 6,
+     7.0 / 216, 7.0 / 216, 7.0 / 216, 7.0 / 216, 7.0 / 216, 1.0 / 36,
+     1.0 / 216, 1.0 / 216, 1.0 / 216, 1.0 / 216, 1.0 / 216, 1.0 / 216},
+    {0,
+     43.0 / 216, 43.0 / 216, 43.0 / 216, 43.0 / 216, 43.0 / 216, 1.0 / 6,
+     7.0 / 216, 7.0 / 216, 7.0 / 216, 7.0 / 216, 7.0 / 216, 1.0 / 36,
+     1.0 / 216, 1.0 / 216, 1.0 / 216, 1.0 / 216, 1.0 / 216, 1.0 / 216},
+};
+
+// Number of capture chances of a colour kept by every thread, must be a power of two
+#define CAPTURE_CACHE_SIZE (1 << 12)
+
+/*
+    Capture chance of one opponent colour as found by colourCaptureChance, the
+    same positions come again and again in the search of Klaus
+*/
+typedef struct
+{
+    uint32_t key;  // Distances, spare sixes, home tokens and progress, 0 if the entry is empty
+    double chance; // Chance that the colour captures the token
+} CaptureEntry;
+
+// Number of games played in lockstep by the batch simulator
+#define BATCH_LANES 1024
+
+// Number of positions in the tablebase, every sorted progress of the four tokens of one colour (61 choose 4)
+#define TABLEBASE_ENTRIES 521855
+
+// File of the tablebase, used by the search bots if it's been built
+#define TABLEBASE_FILE "tablebase.bin"
+
+/*
+    Start of the tablebase file, followed by the expected turns of every
+    position (float) then the best moves of every position (uint16_t)
+*/
+typedef struct
+{
+    char magic[8];     // "LUDOTB1"
+    uint32_t entries;  // TABLEBASE_ENTRIES
+    uint32_t reserved; // 0
+} TablebaseHeader;
+
+// Tablebase mapped from the file, NULL if it's not loaded
+const float *tablebaseTurns = NULL;   // Expected number of turns to finish every position
+const uint16_t *tablebaseMoves = NULL; // Best move of every position, 2 bits for every dice roll as in tablebaseSituation
+
+// Deepest search of Klaus, in moves and turns without a move
+int searchDepth = 4;
+
+/*
+    Value of a position before the dice is rolled, as searched by Klaus
+*/
+typedef struct
+{
+    PackedGame packed; // The position, including whose turn it is
+    uint8_t sixes;     // Number of six already rolled in the turn
+    uint8_t root;      // Colour of the bot the value is for
+    uint8_t depth;     // Depth of the search below the position, 0 if the entry is empty
+    float value;       // Expected value of the position
+} SearchEntry;
+
+/*
+    State of one search of Klaus
+*/
+typedef struct
+{
+    SearchEntry *table; // Transposition table, kept between moves by every thread
+    int root;           // Colour of the bot that's searching
+    long long deadline; // The search is stopped after this (monotonicMillis), 0 if there's no limit
+    bool isTimeout;     // The search is stopped, its values can't be used
+    long nodes;         // Number of positions searched
+} Search;
+
+/*
+    One game as it's played out by Franz, small enough to be copied for every
+    playout. The tokens are kept as their progress like in PackedGame, a board
+    position only ever has the tokens of one colour as the others are captured
+*/
+typedef struct
+{
+    uint8_t progress[4][4]; // Progress of every token, indexed with the colour and the token
+    uint8_t owner[53];      // Colour index + 1 of the tokens on every board position, 0 if it's empty
+    uint8_t stack[53];      // Number of tokens on every board position
+    int playerIndex[4];     // Colour of every player in the turn order
+    int numberOfPlayers;    // Number of players in the game
+    int whosTurn;           // Index of the current player in playerIndex
+    Random rng;             // Random stream for the dice, the moves and the suits
+} Playout;
+
+/*
+    Playouts of one move of Werner, shared by every thread
+*/
+typedef struct
+{
+    Playout start;        // The game before the move
+    int diceNum;          // The dice roll of the move
+    int numberOfSix;      // Number of six already rolled in the turn before diceNum
+    int root;             // Colour index of the bot
+    int rivals;           // Bit of every colour index that has to finish after the bot
+    int moves[4];         // Tokens that can be moved
+    int numberOfMoves;    // Number of tokens that can be moved
+    long limit;           // Most playouts of every thread together, 0 means no limit
+    long long deadline;   // Playouts are stopped after this time in milliseconds, 0 if there's no limit
+    bool isRootParallel;  // Every thread keeps its own statistic
+    uint64_t seed;        // Seed of the playouts, thread n uses splitSeed(seed, n)
+
+    // Written on every playout, so they don't share a cache line with the fields above that are only read
+    _Alignas(CACHE_LINE) atomic_long total; // Number of playouts started by every thread, only counted with a limit
+    atomic_long plays[4]; // Shared playouts of every token, counted when it's started (virtual loss)
+    atomic_long wins[4];  // Shared playouts of every token won by the bot
+} ParallelPlayout;
+
+/*
+    Argument and statistic of each playout thread
+*/
+typedef struct
+{
+    ParallelPlayout *search;
+    int id;        // Index of the thread
+    long plays[4]; // Playouts of every token by the thread, only with root parallel
+    long wins[4];  // Playouts of every token won by the thread, only with root parallel
+} PlayoutWorker;
+
+/*
+    Start of a replay log, the game as it's when the recording starts. It's
+    followed by one byte for every event until the end of the file
+*/
+typedef struct
+{
+    char magic[8];        // REPLAY_MAGIC
+    uint64_t seed;        // State of the random stream when the recording starts
+    Player players[4];    // Same as in GameContext
+    int playerIndex[4];
+    Tokens tokens[4][4];
+    int numberOfBots;
+    int whosTurn;
+    int count;
+    int position;
+} ReplayHeader;
+
+/*
+    The game at the start of every REPLAY_KEYFRAME_INTERVAL turns of a replay
+    log, the events of the turns after it are the changes until the next one
+*/
+typedef struct
+{
+    int32_t count;          // Count of the game at the start of the turn
+    int32_t event;          // Index of the first event of the turn
+    uint8_t progress[4][4]; // Progress of every token as in tokenProgress
+    uint16_t kill[4];       // Kill of every player
+    uint16_t move[4];       // Move of every player
+    int32_t position;       // Rank in the game
+} ReplayKeyframe;
+
+/*
+    End of a replay log that's closed at the end of the game, the keyframes
+    are written just before it so they can be found from the end of the file
+*/
+typedef struct
+{
+    int32_t numberOfKeyframes;
+    int32_t numberOfTurns;
+    char magic[8];          // REPLAY_INDEX_MAGIC
+} ReplayIndex;
+
+/*
+    A replay log in memory
+*/
+typedef struct
+{
+    GameContext start;          // The game when the recording started
+    uint8_t *events;            // Every event of the log
+    long numberOfEvents;
+    ReplayKeyframe *keyframes;  // Keyframe of turn REPLAY_KEYFRAME_INTERVAL * i is keyframes[i]
+    int numberOfKeyframes;
+    int numberOfTurns;          // Number of turns in the log
+} Replay;
+
+/*
+    Bits of one game of an archive, the first bit is the lowest bit of bytes[0]
+*/
+typedef struct
+{
+    uint8_t *bytes;    // ARCHIVE_GAME_SIZE bytes
+    long numberOfBits; // Number of bits written so far
+} BitStream;
+
+/*
+    Start of an archive file, it's followed by chunks until the end of the file
+*/
+typedef struct
+{
+    char magic[8];         // ARCHIVE_MAGIC
+    uint64_t seed;         // Seed of the simulation, game n is started with splitSeed(seed, n)
+    int32_t lineup[4];     // Bot index of every seat as in NUMBER_OF_BOT_TYPES
+    int32_t numberOfSeats;
+    int32_t numberOfGames; // Number of games of the simulation
+} ArchiveHeader;
+
+/*
+    Start of a chunk of an archive, it's followed by the records of its games.
+    A record is a varint of the turns of the game, a varint of the size of
+    its bits in bytes, and the bits
+*/
+typedef struct
+{
+    char magic[4];         // ARCHIVE_CHUNK_MAGIC
+    int32_t firstGame;     // Number of the first game, the others follow without a gap
+    int32_t numberOfGames;
+    int32_t numberOfBytes; // Size of the records
+    uint32_t checksum;     // FNV-1a of the records
+} ArchiveChunk;
+
+/*
+    Chunk that's being filled by one thread of a simulation
+*/
+typedef struct
+{
+    ArchiveChunk header;
+    uint8_t *records; // ARCHIVE_CHUNK_SIZE + ARCHIVE_RECORD_SIZE bytes
+    BitStream game;   // Bits of the game that's being played
+} ArchiveBuffer;
+
+/*
+    Archive that's written while a simulation is played, every thread fills
+    its own chunk so only the writing of a full chunk is locked
+*/
+typedef struct
+{
+    FILE *file;
+    pthread_mutex_t lock;             // Only one chunk is written at a time
+    ArchiveBuffer buffer[MAX_THREAD]; // Chunk of every thread
+    int numberOfBuffers;
+    bool isFailed;                    // A chunk couldn't be written
+} ArchiveWriter;
+
 /*
-    Player array consist of all of the player
-    The array is sorted according to colour
-    red -> index 0
-    green -> index 1
-    yellow -> index 2
-    blue -> index 3
+    Archive that's read one chunk at a time
 */
-Player players[4]; // List of players
+typedef struct
+{
+    FILE *file;
+    ArchiveHeader header;
+    ArchiveChunk chunk;  // Chunk that's being read
+    uint8_t *records;    // Records of the chunk, ARCHIVE_CHUNK_SIZE + ARCHIVE_RECORD_SIZE bytes
+    long next;           // Next byte of the records
+    int gamesLeft;       // Games of the chunk that haven't been read
+    long numberOfChunks; // Number of chunks read so far
+} ArchiveReader;
+
+ReplayKeyframe *recordedKeyframes = NULL; // Keyframes of the replay log, written when it's closed
+int numberOfRecordedKeyframes = 0;
+int recordedKeyframesSize = 0;            // Number of keyframes that fit in recordedKeyframes
+bool isKeyframeStopped = false;           // No more keyframes are kept after running out of memory
 
 /*
-    Array containing the player indexes in the player array
+    Many games played by Jörgen in lockstep, one game per lane. Every array is
+    indexed by the lane last, so one step of every game is a loop over the
+    lanes that the compiler turns into SIMD instructions. Every lane has the
+    same colour to move, a lane that rolled no six just sits out the rest of
+    the turn
 */
-int playerIndex[4];
+typedef struct
+{
+    uint8_t progress[16][BATCH_LANES]; // Progress of every token as in PackedGame, row colour * 4 + token
+    uint32_t rng[BATCH_LANES];         // Random stream of every lane (xorshift32)
+    uint8_t isRolling[BATCH_LANES];    // The current player still rolls in this turn
+    uint8_t finished[BATCH_LANES];     // Bit of every colour that has finished
+    uint8_t place[4][BATCH_LANES];     // Finishing place of every colour, 0 if not finished
+    uint8_t nextPlace[BATCH_LANES];    // Next finishing place
+    uint8_t isPlaying[BATCH_LANES];    // The lane has a game that's not over
+    uint32_t turns[BATCH_LANES];       // Rounds played in the game of every lane
+} BatchGames;
 
 /*
-    Token arrays for each colours
+    Statistic of one bot type, seat or colour in a tournament
+*/
+typedef struct
+{
+    long games;                 // How many games the bot played
+    long place[4];              // How many times the bot finished at each place (1 - 4)
+    long unfinished;            // Games that are stopped before the bot finished
+    long kill;                  // Total kill of the bot
+    long move;                  // Total move of the bot
+    long turns;                 // Total length of the games in turns (count)
+    long score;                 // Total score, as calculateScore would give a user
+    long minScore;              // Lowest score of one game
+    long maxScore;              // Highest score of one game
+    long scores[SCORE_BUCKETS]; // Number of games in every bucket of the score distribution
+} BotStats;
 
-    char col value per colour :
-    Red -> r
-    Green -> g
-    Yellow -> y
-    Blue -> b
+/*
+    Games that are queued for one tournament thread, the owner takes games from
+    the front and idle threads steal half of what's left from the back
 */
-Tokens red[4];
-Tokens green[4];
-Tokens yellow[4];
-Tokens blue[4];
+typedef struct
+{
+    pthread_mutex_t lock;
+    int begin; // Next game to be played
+    int end;   // One past the last game in the queue
+} GameQueue;
 
-int numberOfBots; // Number of bots
-int whosTurn = 1; // Who's take the turn
-int count = 0;    // Count how many turn that already done
-int position = 1; // Rank in the game
+typedef struct
+{
+    int numberOfGames;             // Number of games in the tournament
+    int lineup[4];                 // Bot index of every seat as in NUMBER_OF_BOT_TYPES
+    int numberOfSeats;             // Number of bots in every game (2 - 4)
+    int numberOfThreads;           // Number of threads playing the games
+    uint64_t seed;                 // Seed of the tournament, game n uses splitSeed(seed, n)
+    int format;                    // Format of the result, one of OUTPUT_*
+    FILE *output;                  // Where the result is written
+    GameQueue queue[MAX_THREAD];   // Queue of games for every thread
+    BotStats stats[MAX_THREAD][NUMBER_OF_BOT_TYPES]; // Statistic of every bot type per thread, merged at the end
+    BotStats seatStats[MAX_THREAD][4];               // Statistic of every seat of the lineup per thread
+    BotStats colourStats[MAX_THREAD][4];             // Statistic of every colour per thread
+    ArchiveWriter *archive;                          // Every game is written to it if it's set
+} Tournament;
+
+/*
+    Argument of each tournament thread
+*/
+typedef struct
+{
+    Tournament *tournament;
+    int id; // Index of the thread, also the index of its queue
+} TournamentWorker;
 
 /* Function Prototype */
 
 /*
    Initial State : Not waiting
-   Final State : Waiting is complete
-   Author : Muhammad Fauzan L.
+   Input :
+   @event the event that's just shown, one of PACE_*
+   Final State : Waiting is complete, or skipped by pressing any key
 */
-void WaitForSecond(int time);
+void waitForEvent(int event);
 
 /*
-   Input : None
+   Input :
+   @argc number of arguments after the program name
+   @argv[] arguments after the program name
+   Output : false if there's an invalid option, the usage is already shown
+   Final State : Animation speed, the wait of every event, fast forward, the threads of Werner and the replay logs are set
+*/
+bool parseSpeedOptions(int argc, char *argv[]);
+
+/*
+   Input :
+   @rng the random stream of the game
    Output : Randomized number from 1 to 6 representing dice rolls
    Author : Muhammad Fauzan L.
 */
-int RollADice();
+int RollADice(Random *rng);
+
+/*
+   Initial State : Random stream state is unknown
+   Input :
+   @seed the seed of the stream, the same seed always gives the same numbers
+   Final State : Random stream is seeded
+*/
+void seedRandom(Random *rng, uint64_t seed);
+
+/*
+   Input :
+   @rng the random stream
+   Output : Next 64 bit random number of the stream
+*/
+uint64_t nextRandom(Random *rng);
+
+/*
+   Input :
+   @rng the random stream
+   @n the number of possible value
+   Output : Random number from 0 to n - 1
+*/
+int randomRange(Random *rng, int n);
+
+/*
+   Input :
+   @seed the seed of the whole run (e.g. a tournament)
+   @index the index of the stream (e.g. the game number)
+   Output : Seed of the stream, every index gives an independent stream
+            that doesn't depend on which thread plays it
+*/
+uint64_t splitSeed(uint64_t seed, uint64_t index);
 
 /*
    Input : None
@@ -141,11 +845,13 @@ bool hasColour();
 WINDOW *newWindow(int line, int collumns, int starty, int startx);
 
 /*
-   Initial State : No board in the screen
-   Final State : Board in the screen
+   Initial State : Frame content is unknown
+   Final State : Frame contains the colour of every cell of an empty board
+   Input :
+   @frame the frame that's going to be drawn to
    Author : Muhammad Fauzan L.
 */
-void showBoard();
+void drawBoard(CellFrame frame[15][15]);
 
 /*
     Initial State : Board box are not initialized
@@ -155,11 +861,17 @@ void showBoard();
 void initBoard();
 
 /*
-    Initial State : The board is not empty
-    Final State : Empty board
-    Author : Muhammad Fauzan L.
+    Initial State : The board on the screen may be different from the game
+    Final State : Only the cells that are changed since the last render are
+                  redrawn, with a single update of the screen
+*/
+void renderBoard(GameContext *game);
+
+/*
+    Initial State : The board on the screen is known
+    Final State : Every cell is redrawn on the next render
 */
-void clearBoard();
+void invalidateBoard();
 
 /*
    Initial State : Board is in the screen
@@ -195,11 +907,11 @@ int getUserChoiceinMenu();
     Initial State : Cleared screen
     Final State : New Game menu is shown and the user have enetered a choice
     Input and Output :
-    @choice an array with lenght of 3, consisting of bot id, 0 for Jörgen, 1 for Hans, and 2 for Müller
+    @choice an array with lenght of 3, consisting of bot id, 0 for Jörgen, 1 for Hans, 2 for Müller, 3 for Klaus, 4 for Franz, and 5 for Werner
             value -1 means the slot must be empty
     Author : Muhammad Fauzan L.
 */
-void showNewGameMenu(int choice[3]);
+void showNewGameMenu(GameContext *game, int choice[3]);
 
 /*
     Input : 
@@ -221,12 +933,12 @@ bool isFileExist(char fileName[]);
     Initial State : Bot data are empty (value unknown)
     Input : 
     @botIndexes integer contains bot index from 0 to 2
-                0 for Jörgen, 1 for Hans, and 2 for Müller
+                0 for Jörgen, 1 for Hans, 2 for Müller, 3 for Klaus, 4 for Franz, and 5 for Werner
     @colour integer containing the colour index data, 0 -> red, 1 -> green, 2 -> yellow, 3 -> blue.
     Final State : Bot player data are initialized
     Author : Muhammad Fauzan L.
 */
-void initBotPlayerData(int botIndexes, int colour);
+void initBotPlayerData(GameContext *game, int botIndexes, int colour);
 
 /*
     Initial State : Human player data are empty (value unknown)
@@ -235,17 +947,17 @@ void initBotPlayerData(int botIndexes, int colour);
     Final State : Human player data are initialized
     Author : Muhammad Fauzan L.
 */
-void initHumanPlayerData(int colour);
+void initHumanPlayerData(GameContext *game, int colour);
 
 /*
     Initial State : Player data (bot and human) are empty (value unknown)
     Input :
     @botIndexes integer array with maximum lenght of 3 contains bot index from -1 to 2
-                0 for Jörgen, 1 for Hans, and 2 for Müller. value -1 means there's no player there
+                0 for Jörgen, 1 for Hans, 2 for Müller, 3 for Klaus, 4 for Franz, and 5 for Werner. value -1 means there's no player there
     Final State : Player data (bot and human) are initialized with inputted data
     Author : Muhammad Fauzan L.
 */
-void initPlayerData(int botIndexes[3]);
+void initPlayerData(GameContext *game, int botIndexes[3]);
 
 /*
     Initial State : Opponents in the index position are not known
@@ -257,7 +969,7 @@ void initPlayerData(int botIndexes[3]);
     @opponents[] the resulting opponents if any, or colour 'n' at index 0
     Author : Muhammad Fauzan L.
 */
-void getOpponents(Tokens token, Tokens opponents[], int index);
+void getOpponents(GameContext *game, Tokens token, Tokens opponents[], int index);
 
 /*
     Input :
@@ -274,7 +986,7 @@ int whosOpponents(char color);
     Output : Initialize the token of player that take the turn
     Author : Marissa Nur Amalia
 */
-Tokens getTokens(int index);
+Tokens getTokens(GameContext *game, int index);
 
 /*
     Initial State : Token in initial position
@@ -287,35 +999,330 @@ Tokens getTokens(int index);
     Author : Marissa Nur Amalia
     Version : v.2
 */
-void moveToken(int diceNum, Tokens temp, char posmov, int numOfToken);
+void moveToken(GameContext *game, int diceNum, Tokens temp, char posmov, int numOfToken);
 
 /*
-    Initial State : The token that want to be move not yet choosen
+    Initial State : Opponents on the destination of the token are not known
+    Final State : Opponents are known
     Input :
-    @posmov[] array of possible move of tokens that user have
-    Output : The token that want to be move is choosen
+    @diceNum the dice number that shown up
+    @temp the token that's going to be moved
+    @posmov possible move of the token
+    Output :
+    @opponents[] the opponents on the destination if any, or colour 'n' at index 0
 */
-int getNumOfToken(char posmov[]);
+void getMoveOpponents(GameContext *game, int diceNum, Tokens temp, char posmov, Tokens opponents[]);
 
 /*
-    Initial State : [token ingin dicek posibilitas geraknya (?)]
+    Input :
+    @temp the token that's going to be moved
+    @opponents[] the opponents on the destination as given by getMoveOpponents
+    Output : true if the move ends up on an opponent and a suit has to be played
+*/
+bool isCapture(Tokens temp, Tokens opponents[]);
+
+/*
+    Initial State : Token in initial position
     Input :
     @diceNum the dice number that shown up
-    @pos the token's position that want to check
-    @safe is the token in the safe zone or not
-    Output : the possibility of token to move, to out from home, or can't move
-             'm' means the token can move
-             'o' means the token can get out of the home base
-             's' means stuck
-    Author : Marissa Nur Amalia
+    @temp the token that's going to be moved
+    @posmov possible move of the token
+    @numOfToken the number of token of the player that want to be move
+    @opponents[] the opponents on the destination as given by getMoveOpponents
+    @whosWin result of the suit as in suitCheck, only used if there's a capture
+    Final State : Token in the desired position or back to home base if it lost the suit,
+                  the rules state (moves, kills, position) are updated. Nothing is drawn.
 */
-char possibleMove(int diceNum, int pos, bool safe);
+void applyMove(GameContext *game, int diceNum, Tokens temp, char posmov, int numOfToken, Tokens opponents[], int whosWin);
 
 /*
-    Initial State : User didn't know the possible move of token
-    Final State : Get and show user possibility of token to move, to out from home, or can't move
     Input :
-    @temp[] array of token containing tokens that's going to be moved
+    @diceNum the dice roll of the current player
+    Output : Number of legal moves, 0 if no token can be moved
+    @moves[4] every legal move of the current player
+*/
+int generateMoves(GameContext *game, int diceNum, Move moves[4]);
+
+/*
+    Initial State : The move is legal for the current player
+    Input :
+    @diceNum the dice roll of the move
+    @move the move as given by generateMoves
+    @whosWin result of the suit as in applyMove, only used if there's a capture
+    Final State : The move is applied as in applyMove
+*/
+void playMove(GameContext *game, int diceNum, Move *move, int whosWin);
+
+// Chance that the player who takes the turn wins a suit of suitBotVsBot,
+// suitCheck lets the first player win four of the six outcomes that aren't a draw
+#define SUIT_WIN_CHANCE (2.0 / 3)
+
+/*
+    Input :
+    @rng the random stream of the game
+    Output : Result of a suit played between two bots as in suitCheck, 1 or 2 (never a draw)
+*/
+int suitBotVsBot(Random *rng);
+
+/*
+    Input :
+    @posmov[] array of possible move that passed to bot
+    @temp[] the tokens of bot that takes the turn
+    @diceNum the dice number that shown up
+    @numberOfSix number of six already rolled in the turn before diceNum
+    Output : Number of token that the bot of the current player want to move
+*/
+int botChooseToken(GameContext *game, char posmov[], Tokens temp[], int diceNum, int numberOfSix);
+
+/*
+    Initial State : A turn of a bot haven't been played yet
+    Final State : The turn is done, without any drawing, input or waiting
+    Output :
+    @bits the rolls, tokens and suit outcomes of the turn are added if it's not NULL
+*/
+void headlessTurn(GameContext *game, BitStream *bits);
+
+/*
+    Initial State : A turn of a bot in the game on the screen haven't been played yet
+    Final State : The turn is done without drawing or waiting, unless the human
+                  has to play a suit
+    Output :
+    @summary one line of the rolls, the moves and the captures of the turn
+*/
+void fastForwardTurn(GameContext *game, char summary[]);
+
+/*
+    Input : None
+    Output : true if at most one of the players still haven't finished
+*/
+bool isHeadlessGameOver(GameContext *game);
+
+/*
+    Initial State : Player data are empty (value unknown)
+    Input :
+    @botIndexes[4] bot index for every colour as in initBotPlayerData (0 -> red, 1 -> green, 2 -> yellow, 3 -> blue),
+                   value -1 means there's no player with that colour
+    @seed seed of the random stream of the game
+    Final State : Every player is a bot, the turn order follows the colour order
+*/
+void initHeadlessPlayerData(GameContext *game, int botIndexes[4], uint64_t seed);
+
+/*
+    Initial State : Player data are initialized with initHeadlessPlayerData
+    Final State : The game is played until it's over, without curses
+    Output :
+    @rank[4] finishing place of every colour (1 - 4), 0 if the colour is not playing or didn't finish
+    @bits every turn is added as headlessTurn adds it if it's not NULL
+*/
+void playHeadlessGame(GameContext *game, int rank[4], BitStream *bits);
+
+/*
+    Initial State : A turn of the game is played, the turn haven't moved to the next
+    Output :
+    @rank[4] the player of the turn gets the next place if it has just finished
+    @place next finishing place, moved if the player has finished
+*/
+void rankHeadlessTurn(GameContext *game, int rank[4], int *place);
+
+/*
+    Initial State : The game is over or stopped
+    Input :
+    @place next finishing place
+    Output :
+    @rank[4] the last player standing gets the last place, if the game is over
+*/
+void rankLastPlayer(GameContext *game, int rank[4], int place);
+
+/*
+    Input :
+    @text bots separated by comma, j for Jörgen, h for Hans, m for Müller, k for Klaus, f for Franz, and w for Werner (e.g. "j,h,m,w")
+    Output :
+    @lineup[4] bot index of every seat
+    @numberOfSeats number of bots in the lineup
+    true if the text is a valid lineup of 2 to 4 bots, otherwise false
+*/
+bool parseLineup(char text[], int lineup[4], int *numberOfSeats);
+
+/*
+    Input : None
+    Output : Number of hardware threads, at least 1 and at most MAX_THREAD
+*/
+int getNumberOfThreads();
+
+/*
+    Initial State : The game haven't been played
+    Input :
+    @tournament the tournament the game belongs to
+    @gameNumber number of the game, used to rotate the colour of every seat
+    @thread index of the thread that plays the game
+    Final State : The game is played and the result is added to the statistic
+                  of every bot type, seat and colour of the thread
+*/
+void playTournamentGame(Tournament *tournament, int gameNumber, int thread);
+
+/*
+    Input :
+    @lineup[4] bot index of every seat
+    @numberOfSeats number of bots in the lineup
+    @gameNumber number of the game
+    Output :
+    @botIndexes[4] bot index of every colour, -1 if the colour is not playing.
+                   The colours are rotated so every seat plays every colour evenly
+*/
+void lineupColours(int lineup[4], int numberOfSeats, int gameNumber, int botIndexes[4]);
+
+/*
+    Input :
+    @game the finished game
+    @gameNumber number of the game
+    @thread index of the thread that played the game
+    @rank[4] finishing place of every colour
+    Final State : The result is added to the statistic of every bot type, seat
+                  and colour of the thread
+*/
+void addTournamentGame(Tournament *tournament, GameContext *game, int gameNumber, int thread, int rank[4]);
+
+/*
+    Input :
+    @game the finished game
+    @colour colour index of the player
+    @rank finishing place of the player, 0 if the player didn't finish
+    Final State : The result of the player is added to stats
+    Output :
+    @stats the statistic of the bot type, seat or colour of the player
+*/
+void addGameStats(BotStats *stats, GameContext *game, int colour, int rank);
+
+/*
+    Input :
+    @stats statistic of one thread
+    Final State : stats is added to total
+    Output :
+    @total the merged statistic
+*/
+void mergeBotStats(BotStats *total, BotStats *stats);
+
+/*
+    Input :
+    @queue the queue of the thread
+    Output :
+    @gameNumber the next game in the queue
+    true if there's a game left in the queue, otherwise false
+*/
+bool takeGame(GameQueue *queue, int *gameNumber);
+
+/*
+    Initial State : The queue of the thread is empty
+    Input :
+    @tournament the running tournament
+    @thief index of the thread that's stealing
+    Final State : Half of the games left in another queue are moved to the queue of the thief
+    Output : true if any game is stolen, false if every queue is empty
+*/
+bool stealGames(Tournament *tournament, int thief);
+
+/*
+    Input :
+    @arg the TournamentWorker of the thread
+    Output : None, the thread stops when there's no games left to play or steal
+*/
+void *tournamentWorker(void *arg);
+
+/*
+    Initial State : Tournament data are initialized
+    Final State : Every game is played and the merged statistic is printed
+*/
+void runTournament(Tournament *tournament);
+
+/*
+    Initial State : Every game is played
+    Final State : The statistic of every thread is merged and printed
+*/
+void showTournamentResult(Tournament *tournament);
+
+/*
+    Initial State : Tournament result is not shown
+    Input :
+    @tournament the finished tournament
+    @total[] statistic of every bot type over every thread
+    Final State : The result is printed to the standard output
+*/
+void printTournamentResult(Tournament *tournament, BotStats total[NUMBER_OF_BOT_TYPES]);
+
+/*
+    Input :
+    @file where the row is written
+    @group bot, seat or colour
+    @name name of the bot type, seat or colour
+    @stats its statistic
+    Final State : One CSV row is written to the file, nothing if there's no games
+*/
+void printStatsCsv(FILE *file, char group[], char name[], BotStats *stats);
+
+/*
+    Input :
+    @file where the object is written
+    @name name of the bot type, seat or colour
+    @stats its statistic
+    @isFirst false if a comma has to be written before the object
+    Final State : One JSON object is written to the file
+*/
+void printStatsJson(FILE *file, char name[], BotStats *stats, bool isFirst);
+
+/*
+    Initial State : Simulation result is not shown
+    Input :
+    @tournament the finished simulation
+    @total[] statistic of every bot type over every thread
+    @seats[] statistic of every seat over every thread
+    @colours[] statistic of every colour over every thread
+    Final State : The result is written to the output as CSV or JSON
+*/
+void printSimulationResult(Tournament *tournament, BotStats total[NUMBER_OF_BOT_TYPES], BotStats seats[4], BotStats colours[4]);
+
+/*
+    Input :
+    @argc number of arguments after --tournament
+    @argv[] arguments after --tournament, the number of games and optionally the lineup and the seed
+    Output : Exit code of the program
+*/
+int tournamentCommand(int argc, char *argv[]);
+
+/*
+    Input :
+    @argc number of arguments after --simulate
+    @argv[] the number of games, then --players, --seed, --threads, --format and --output
+    Output : Exit code of the program
+*/
+int simulateCommand(int argc, char *argv[]);
+
+/*
+    Initial State : The token that want to be move not yet choosen
+    Input :
+    @posmov[] array of possible move of tokens that user have
+    Output : The token that want to be move is choosen
+*/
+int getNumOfToken(char posmov[]);
+
+/*
+    Initial State : [token ingin dicek posibilitas geraknya (?)]
+    Input :
+    @diceNum the dice number that shown up
+    @pos the token's position that want to check
+    @safe is the token in the safe zone or not
+    Output : the possibility of token to move, to out from home, or can't move
+             'm' means the token can move
+             'o' means the token can get out of the home base
+             's' means stuck
+    Author : Marissa Nur Amalia
+*/
+char possibleMove(int diceNum, int pos, bool safe);
+
+/*
+    Initial State : User didn't know the possible move of token
+    Final State : Get and show user possibility of token to move, to out from home, or can't move
+    Input :
+    @temp[] array of token containing tokens that's going to be moved
     @diceNum the current dice roll
     Output :
     @posmov the array of possible move of the token temp[]
@@ -339,7 +1346,7 @@ bool validateInputToken(int choosenToken);
     Final State : the token is in desired position
     Author : Marissa Nur Amalia
 */
-void moveForward(int diceNum, int numOfToken);
+void moveForward(GameContext *game, int diceNum, int numOfToken);
 
 /*
     Initial State : Token in initial position
@@ -349,7 +1356,7 @@ void moveForward(int diceNum, int numOfToken);
     Final State : Token is back to home
     Author : Marissa Nur Amalia
 */
-void toHomeBase(int numOfToken, int index);
+void toHomeBase(GameContext *game, int numOfToken, int index);
 
 /*
     Initial State : Token is in home
@@ -358,7 +1365,7 @@ void toHomeBase(int numOfToken, int index);
     Final State : Token is out home
     Author : Marissa Nur Amalia
 */
-void outFromHomeBase(int numOfToken);
+void outFromHomeBase(GameContext *game, int numOfToken);
 
 /*
     Initial State : Token is in home
@@ -368,7 +1375,122 @@ void outFromHomeBase(int numOfToken);
     Final State : Token is in safe zone
     Author : Marissa Nur Amalia
 */
-void moveToSafeZone(int numOfToken, int diceNum);
+void moveToSafeZone(GameContext *game, int numOfToken, int diceNum);
+
+/*
+    Input :
+    @token the token that's going to be packed
+    Output : Progress of the token from its home base as in PackedGame (0 - 57)
+*/
+int tokenProgress(Tokens token);
+
+/*
+    Input :
+    @colour colour index of the token, 0 -> red, 1 -> green, 2 -> yellow, 3 -> blue
+    @numOfToken the index number of the token
+    @progress progress of the token as in PackedGame (0 - 57)
+    Output : The token with every field filled in
+*/
+Tokens progressToToken(int colour, int numOfToken, int progress);
+
+/*
+    Input : The game that's going to be packed
+    Output :
+    @packed the tokens, the playing colours and the turn of the game
+*/
+void packGame(GameContext *game, PackedGame *packed);
+
+/*
+    Initial State : The player data and turn order of the game are initialized
+    Input :
+    @packed the packed tokens and turn
+    Final State : Tokens, whosTurn, occupancy index and bitboards are the same as the packed game
+*/
+void unpackGame(PackedGame *packed, GameContext *game);
+
+/*
+    Input :
+    @colour colour index of the tokens, 0 -> red, 1 -> green, 2 -> yellow, 3 -> blue
+    Output : Pointer to the token array of the colour
+*/
+Tokens *getColourTokens(GameContext *game, int colour);
+
+/*
+    Initial State : Occupancy index and hash are not known (e.g. after loading a game)
+    Final State : Occupancy index matches every token on the board, the hash
+                  matches the tokens and the turn
+*/
+void buildOccupancy(GameContext *game);
+
+/*
+    Initial State : Zobrist keys are empty
+    Final State : Every Zobrist key is filled, called once before any game
+*/
+void initZobrist();
+
+/*
+    Input : None
+    Output : Zobrist hash of the tokens and the turn, computed from every token
+*/
+uint64_t computeHash(GameContext *game);
+
+/*
+    Input :
+    @colour colour index of the token
+    @numOfToken the index number of the token
+    Final State : The key of the token at its current progress is added to the
+                  hash, or removed if it's already there
+*/
+void hashToken(GameContext *game, int colour, int numOfToken);
+
+/*
+    Input :
+    @sixes number of six already rolled in the turn
+    Output : Zobrist hash of the position before the current player rolls the dice
+*/
+uint64_t positionHash(GameContext *game, int sixes);
+
+/*
+    Initial State : Token is not in the occupancy index
+    Input :
+    @colour colour index of the token
+    @numOfToken the index number of the token
+    Final State : Token is in the occupancy index if it's on the board
+*/
+void placeToken(GameContext *game, int colour, int numOfToken);
+
+/*
+    Initial State : Token might be in the occupancy index
+    Input :
+    @colour colour index of the token
+    @numOfToken the index number of the token
+    Final State : Token is not in the occupancy index
+*/
+void liftToken(GameContext *game, int colour, int numOfToken);
+
+/*
+    Input :
+    @token the token whose opponents are searched
+    @index the position that's going to be checked, can be more than 52 or less than 1
+    Output : Bits of the opponents tokens in the position as in the occupancy index
+*/
+uint16_t opponentsAt(GameContext *game, Tokens token, int index);
+
+/*
+    Input :
+    @token the token whose opponents are searched
+    Output : Ring bitboard of every opponents token on the board
+*/
+uint64_t opponentsRing(GameContext *game, Tokens token);
+
+/*
+    Input :
+    @ring a ring bitboard
+    @index the first position of the window, can be more than 52 or less than 1
+    @length the number of positions in the window (1 - 52)
+    Output : Bits of the window, position index is bit 0
+*/
+uint64_t ringWindow(uint64_t ring, int index, int length);
 
 /*
     Initial State : in the beginning of turn, the variable whosTurn
@@ -376,7 +1498,7 @@ void moveToSafeZone(int numOfToken, int diceNum);
     Author : Marissa Nur Amalia
     Version : v.2
 */
-void moveToNextTurn();
+void moveToNextTurn(GameContext *game);
 
 /*
     Input : 
@@ -431,11 +1553,12 @@ int suitCheck(int player1, int player2);
 void suitMenu(int *choice);
 
 /*
-    Input : None
+    Input :
+    @rng the random stream of the game
     Output : Random number from 1 to 3, symbolizing the suit
     Author : Muhammad Fauzan L.
 */
-int suitRandom();
+int suitRandom(Random *rng);
 
 /*
     Initial State : The inputted string are not shown in option box
@@ -461,11 +1584,13 @@ void printToOptionBox(char input[], int x, int y);
 void positionToCoordinate(Tokens token, int *x, int *y);
 
 /*
-    Initial State : Tokens are not shown on the board
-    Final State : Tokens are shown on the board
+    Initial State : Tokens are not in the frame
+    Final State : Tokens are drawn on top of the board in the frame
+    Input :
+    @frame the frame that's going to be drawn to
     Author : Muhammad Fauzan L.
 */
-void printTokens();
+void drawTokens(GameContext *game, CellFrame frame[15][15]);
 
 /*
     Input :
@@ -488,21 +1613,21 @@ int tokenCharToInt(char token);
     Output : Status of game, is it game over or not
     Author : Marissa Nur Amalia
 */
-bool isGameOver();
+bool isGameOver(GameContext *game);
 
 /*
     Input : None
     Output : is all bot win or not
     Author : Marissa Nur Amalia
 */
-bool isAllBotWin();
+bool isAllBotWin(GameContext *game);
 
 /*
     Input : None
     Output : is user already win or not
     Author : Marissa Nur Amalia
 */
-bool isUserWin();
+bool isUserWin(GameContext *game);
 
 /*
     Input :
@@ -512,7 +1637,7 @@ bool isUserWin();
     Final State : the array of token that want to be checked is initialized
     Author : Marissa Nur Amalia
 */
-void tokensOfPlayer(Tokens token[], int index);
+void tokensOfPlayer(GameContext *game, Tokens token[], int index);
 
 /*
     Input :
@@ -520,7 +1645,7 @@ void tokensOfPlayer(Tokens token[], int index);
     Output : Status of player is it already win or not (finished or not)
     Author : Marissa Nur Amalia
 */
-bool isItWin(int index);
+bool isItWin(GameContext *game, int index);
 
 /*
     Initial State : The Highscore are not shown on screen
@@ -566,14 +1691,22 @@ bool isHighScore(int caHighScore);
     Final State : A turn is done
     Author : Muhammad Fauzan L.
 */
-void aTurn();
+void aTurn(GameContext *game);
 
 /*
-    Input : None
+    Initial State : Bot turns are played without drawing
+    Final State : The board is drawn and the summary of the bot turns is shown
+                  until the user press any key
+*/
+void showTurnSummary(GameContext *game);
+
+/*
+    Input :
+    @rng the random stream of the game
     Output : Dice number as rolled by user
     Author : Muhammad Fauzan L.
 */
-int getDiceRoll();
+int getDiceRoll(Random *rng);
 
 /*
     Initial State : User raise the interrupt signal
@@ -591,7 +1724,7 @@ void pauseHandler(int signum);
     Output : Number of token that bot want to move
     Author : Marissa Nur Amalia
 */
-int botJorgen(char posmov[], Tokens temp[]);
+int botJorgen(GameContext *game, char posmov[], Tokens temp[]);
 
 /*
     Input :
@@ -601,3524 +1734,7757 @@ int botJorgen(char posmov[], Tokens temp[]);
     Output : Number of token that bot want to move
     Author : Marissa Nur Amalia
 */
-int botHans(char posmov[], Tokens temp[], int diceNum);
+int botHans(GameContext *game, char posmov[], Tokens temp[], int diceNum);
 
 /*
     Initial State : User in-game
     Final State : The state of the game are saved into file
     Author : Muhammad Fauzan L.
 */
-void saveGamestate();
+void saveGamestate(GameContext *game);
 
 /*
     Initial State : Game data are empty and user choose to resume
     Final State : The game data are the same as in the file
     Author : Muhammad Fauzan L.
 */
-void getGameState();
+void getGameState(GameContext *game);
+
+/*
+    Initial State : The game is about to start or to be resumed
+    Final State : If recordName is set the replay log is opened and the header
+                  is written, otherwise nothing is done
+*/
+void startRecording(GameContext *game);
 
 /*
     Input :
-    @token the array of bot's token that want to checked
-    @index the board number that want to checked
-    Output : Is bot has opponents near the tokens
-    Author : Marissa Nur Amalia
+    @type one of REPLAY_*
+    @value value of the event
+    Final State : The event is written to the replay log if there's one
 */
-bool isBotHasOpponents(Tokens token, int index);
+void recordEvent(int type, int value);
 
 /*
-    Initial State : Labels are not shown
-    Final State : Label of every player are shown
-    Author : Muhammad Fauzan L.
+    Initial State : The turn is over and it's the turn of the next player
+    Final State : The end of the turn is written to the replay log if there's one
 */
-void showLabel();
+void recordTurn(GameContext *game);
 
 /*
-    Input :
-    @token token that's going to be searched for enemy behind it
-    @index the position that's going to be checked
-    Output :true if there's any or false if there's none
-    Author : Muhammad Fauzan L.
+    Final State : A keyframe of the game is kept if it's the start of a
+                  multiple of REPLAY_KEYFRAME_INTERVAL turns
 */
-bool isThereOpponentsBehind(Tokens token, int index);
+void recordTurnKeyframe(GameContext *game);
 
 /*
     Input :
-    @posmov[] the possibility of moving tokens
-    @temp the token owned by the bot
-    @diceNum the current diceroll
-    Output : Number of token that's going to be moved
-    Author : Muhammad Fauzan L.
+    @event index of the first event of the turn
+    Output :
+    @keyframe the game at the start of the turn
 */
-int botMuller(char posmov[], Tokens temp[], int diceNum);
+void makeKeyframe(GameContext *game, long event, ReplayKeyframe *keyframe);
 
 /*
     Input :
-    @position winning position of the user
-    Output : The score of the player
-    Author : Muhammad Fauzan L.
+    @replay the replay log
+    @keyframe one of its keyframes
+    Output :
+    @game the game of the keyframe
 */
-int calculateScore(int position);
+void restoreKeyframe(Replay *replay, ReplayKeyframe *keyframe, GameContext *game);
 
 /*
-    Initial State : Screen is empty
-    Final State : Shows win message
-    Author : Muhammad Fauzan L.
+    Initial State : The game is over or left
+    Final State : The keyframes and their index are written at the end of the replay log and it's closed
 */
-void showWin();
+void stopRecording();
 
 /*
-    Initial State : Screen is empty
-    Final State : Shows lose message
-    Author : Muhammad Fauzan L.
+    Input :
+    @name file name of the replay log
+    Output :
+    @replay the game when the recording started, the events and the
+            keyframes if the log has them, allocated with malloc
+    true if the file is a replay log, otherwise false
 */
-void showLose();
+bool loadReplay(char name[], Replay *replay);
 
 /*
-    Initial State : User score is known to be a new highscore
-    Final State : User has inputted a name and the score is written to the file
-    Input :
-    @score the new highscore score
-    Author : Muhammad Fauzan L.
+    Initial State : The log has no keyframes, it wasn't closed at the end of the game
+    Final State : The keyframes are made by playing every turn of the log
+    Output : false if the log breaks the rules
 */
-void newHighScoreMenu(int score);
+bool buildKeyframes(Replay *replay);
 
-int main()
-{
-    int choice[3];
+/*
+    Input :
+    @turn the turn, 0 for the first turn of the log
+    Output :
+    @game the game at the start of the turn, from the keyframe before it
+          and at most REPLAY_KEYFRAME_INTERVAL - 1 turns played after
+    @next index of the first event of the turn
+    false if the log breaks the rules
+*/
+bool seekReplay(Replay *replay, int turn, GameContext *game, long *next);
+
+/*
+    Initial State : It's the turn of the next player of the log
+    Input :
+    @events[] events of the log
+    @numberOfEvents number of events
+    @next index of the next event
+    @isShown the moves are drawn on the board at the animation speed
+    Final State : The events of the turn are played through the rules,
+                  next is after the end of the turn
+    Output :
+    @summary[] what happened in the turn, as in fastForwardTurn
+    1 if the turn is played, 0 if there's no event left, -1 if the log
+    breaks the rules at event next - 1
+*/
+int replayTurn(GameContext *game, uint8_t events[], long numberOfEvents, long *next, char summary[], bool isShown);
+
+/*
+    Initial State : Curses is started
+    Final State : The turns of the log are shown on the board one at a time,
+                  going forward, backward or to any turn, until the user quits
+*/
+void viewReplay(Replay *replay);
+
+/*
+    Input :
+    @name file name of the replay log
+    Output : Exit code of the program
+    Final State : The game of the log is played again, every turn is printed
+                  or, if isWatching, shown on the board at the animation
+                  speed, or, if isViewing, browsed one turn at a time
+*/
+int replayCommand(char name[]);
+
+/*
+    Input :
+    @value the value that's written
+    @count number of bits of the value
+    Final State : The lowest count bits of value are added after the bits
+    Output :
+    @bits the bits of the game
+*/
+void writeBits(BitStream *bits, int value, int count);
+
+/*
+    Input :
+    @bytes bits that are read, the first bit is the lowest bit of bytes[0]
+    @size size of bytes
+    @count number of bits of the value
+    Output : The value, or -1 if there are not enough bits left
+    Final State : next is moved after the value
+*/
+int readBits(uint8_t bytes[], long size, long *next, int count);
+
+/*
+    Input :
+    @value the value that's written
+    Final State : The value is added to bytes at size, 7 bits in every byte
+                  starting from the lowest, the high bit is set if a byte follows
+    Output :
+    @bytes the records of a chunk
+    @size size of bytes, moved after the varint
+*/
+void writeVarint(uint8_t bytes[], long *size, uint32_t value);
+
+/*
+    Input :
+    @bytes the records of a chunk
+    @size size of bytes
+    @next next byte of bytes
+    Output :
+    @value the varint at next
+    true if the varint is complete, otherwise false
+    Final State : next is moved after the varint
+*/
+bool readVarint(uint8_t bytes[], long size, long *next, uint32_t *value);
+
+/*
+    Input :
+    @bytes the records of a chunk
+    @size size of bytes
+    Output : FNV-1a hash of the bytes
+*/
+uint32_t archiveChecksum(uint8_t bytes[], long size);
+
+/*
+    Input :
+    @name file name of the archive
+    @tournament the simulation that's written, the threads are set
+    Output : The archive that's written, NULL if the file can't be written
+             or there's not enough memory
+*/
+ArchiveWriter *openArchiveWriter(char name[], Tournament *tournament);
+
+/*
+    Input :
+    @archive the archive that's written
+    @thread index of the thread that plays the game
+    Output : The bits of the game, empty
+*/
+BitStream *startArchiveGame(ArchiveWriter *archive, int thread);
+
+/*
+    Initial State : The bits of the game are in the buffer of the thread
+    Input :
+    @archive the archive that's written
+    @thread index of the thread that played the game
+    @gameNumber number of the game
+    @turns number of turns of the game
+    Final State : The record of the game is added to the chunk of the thread,
+                  the chunk is written if it's full or the game doesn't follow
+                  the last game of the chunk
+*/
+void addArchiveGame(ArchiveWriter *archive, int thread, int gameNumber, int turns);
+
+/*
+    Input :
+    @archive the archive that's written
+    @thread index of the thread of the chunk
+    Final State : The chunk is written to the file if it has any game, and emptied
+*/
+void flushArchiveChunk(ArchiveWriter *archive, int thread);
+
+/*
+    Input :
+    @archive the archive that's written
+    Output : true if every chunk is written, otherwise false
+    Final State : The last chunks are written, the file is closed and the archive is freed
+*/
+bool closeArchiveWriter(ArchiveWriter *archive);
+
+/*
+    Input :
+    @name file name of the archive
+    Output :
+    @reader the archive, before its first chunk
+    true if the file is an archive, otherwise false
+*/
+bool openArchive(char name[], ArchiveReader *reader);
+
+/*
+    Initial State : game is at the start of a turn of an archived game
+    Input :
+    @bytes bits of the game
+    @size size of bytes
+    @next next bit of the game
+    Output :
+    @events the replay events of the turn are added at numberOfEvents
+    true if the bits are a valid turn, otherwise false
+    Final State : The turn is played as the bits say, next and numberOfEvents
+                  are moved after the turn
+*/
+bool decodeArchiveTurn(GameContext *game, uint8_t bytes[], long size, long *next, uint8_t events[], long *numberOfEvents);
+
+/*
+    Input :
+    @reader the archive that's read
+    Output :
+    @game the game at its end
+    @events every replay event of the game, ARCHIVE_EVENTS_SIZE bytes
+    @numberOfEvents number of events
+    @gameNumber number of the game
+    @rank[4] finishing place of every colour as in playHeadlessGame
+    1 if a game is read, 0 at the end of the archive, -1 if the archive is broken
+    Final State : The next chunk is read if every game of the chunk is read
+*/
+int readArchiveGame(ArchiveReader *reader, GameContext *game, uint8_t events[], long *numberOfEvents, int *gameNumber, int rank[4]);
+
+/*
+    Input :
+    @reader the archive that's read
+    Final State : The file is closed and the chunk is freed
+*/
+void closeArchive(ArchiveReader *reader);
+
+/*
+    Input :
+    @argc number of arguments after --read-archive
+    @argv the arguments, the archive and the options
+    Output : Exit code of the program
+    Final State : The statistic of every game of the archive is written as
+                  --simulate writes it, or the turns of one game are printed
+*/
+int readArchiveCommand(int argc, char *argv[]);
+
+/*
+    Input :
+    @token the array of bot's token that want to checked
+    @index the board number that want to checked
+    Output : Is bot has opponents near the tokens
+    Author : Marissa Nur Amalia
+*/
+bool isBotHasOpponents(GameContext *game, Tokens token, int index);
+
+/*
+    Initial State : Labels are not shown
+    Final State : Label of every player are shown
+    Author : Muhammad Fauzan L.
+*/
+void showLabel(GameContext *game);
+
+/*
+    Input :
+    @behind[4] distance of every token of one opponent colour that can still come
+               to the token (1 - CAPTURE_DISTANCE) without turning into its safezone
+    @numberOfTokens number of distances in behind[]
+    @spare number of sixes the other tokens of the colour on the board can be moved with
+    @home number of tokens of the colour in the home base, 0 if its start is more
+          than CAPTURE_DISTANCE from the token (they're counted in spare then)
+    @progress position of the token as relpos of the colour (1 - 51)
+    @rollsLeft number of rolls after this one if it's a six (0 - 2)
+    Output : Chance that the colour captures the token with the rest of its turn,
+             moving the token that gives the best chance with every six
+*/
+double colourCaptureChance(int behind[4], int numberOfTokens, int spare, int home, int progress, int rollsLeft);
+
+/*
+    Input : Same as colourCaptureChance, without rollsLeft
+    Output : Chance that the colour captures the token in its turn, from the cache
+             of the calling thread if it's there
+*/
+double cachedCaptureChance(int behind[4], int numberOfTokens, int spare, int home, int progress);
+
+/*
+    Output : Capture chance cache of the calling thread, allocated on the first call
+*/
+CaptureEntry *getCaptureCache();
+
+/*
+    Input :
+    @relpos relpos of a token on the board
+    Output : Number of sixes the token can be moved with before it's in the
+             safezone, where a six can't move it anymore. At most 2, as the
+             third six ends the turn
+*/
+int sixMovesLeft(int relpos);
+
+/*
+    Input :
+    @token the token that might be captured
+    Output : Chance that an opponent captures the token in their next turns, 0 in
+             the home base or in the safezone. Every colour rolls their own dice, so
+             the chance of every colour is found on its own
+*/
+double captureProbability(GameContext *game, Tokens token);
+
+/*
+    Input :
+    @token token that's going to be searched for enemy behind it
+    @index the position that's going to be checked
+    Output :true if there's any or false if there's none
+    Author : Muhammad Fauzan L.
+*/
+bool isThereOpponentsBehind(GameContext *game, Tokens token, int index);
+
+/*
+    Input :
+    @posmov[] the possibility of moving tokens
+    @temp the token owned by the bot
+    @diceNum the current diceroll
+    Output : Number of token that's going to be moved
+    Author : Muhammad Fauzan L.
+*/
+int botMuller(GameContext *game, char posmov[], Tokens temp[], int diceNum);
+
+/*
+    Input :
+    @posmov[] the possibility of moving tokens
+    @temp the token owned by the bot
+    @diceNum the current diceroll
+    @numberOfSix number of six already rolled in the turn before diceNum
+    Output : Number of token with the best expected value, searched with
+             expectimax over the dice rolls until searchDepth or searchBudget
+*/
+int botKlaus(GameContext *game, char posmov[], Tokens temp[], int diceNum, int numberOfSix);
+
+/*
+    Input :
+    @colour colour index of the player
+    Output : Value of the tokens of the player, the further the better and less
+             if there's opponents that can capture the token
+*/
+double evaluateColour(GameContext *game, int colour);
+
+/*
+    Input :
+    @root colour index of the bot that's searching
+    Output : Value of the position for the bot, compared to its strongest opponent
+*/
+double evaluatePosition(GameContext *game, int root);
+
+/*
+    Output : Transposition table of the calling thread, allocated on the first call
+*/
+SearchEntry *getSearchTable();
+
+/*
+    Input :
+    @sixes number of six already rolled in the turn
+    @depth depth of the search below the position
+    Output : Expected value of the position before the current player rolls the dice
+*/
+double searchChance(GameContext *game, Search *search, int sixes, int depth);
+
+/*
+    Input :
+    @diceNum the dice roll of the current player
+    @sixes number of six already rolled in the turn before diceNum
+    @depth depth of the search below the position
+    Output : Value of the best move for the current player, the searching bot
+             takes the highest value and the opponents the lowest
+*/
+double searchDice(GameContext *game, Search *search, int diceNum, int sixes, int depth);
+
+/*
+    Input :
+    @diceNum the dice roll of the current player
+    @sixes number of six already rolled in the turn before diceNum
+    @depth depth of the search below the position
+    @move the move of the current player as given by generateMoves
+    Output : Expected value after the move, a capture is won SUIT_WIN_CHANCE of the time
+*/
+double searchMove(GameContext *game, Search *search, int diceNum, int sixes, int depth, Move *move);
+
+/*
+    Input :
+    @posmov[] the possibility of moving tokens
+    @temp the token owned by the bot
+    @diceNum the current diceroll
+    @numberOfSix number of six already rolled in the turn before diceNum
+    Output : Number of token with the highest win rate in random playouts, the
+             moves are tried until playoutLimit or searchBudget
+*/
+int botFranz(GameContext *game, char posmov[], Tokens temp[], int diceNum, int numberOfSix);
+
+/*
+    Input :
+    @posmov[] the possibility of moving tokens
+    @temp the token owned by the bot
+    @diceNum the current diceroll
+    @numberOfSix number of six already rolled in the turn before diceNum
+    Output : Number of token with the highest win rate in random playouts like
+             Franz, with the playouts spread over playoutThreads threads
+*/
+int botWerner(GameContext *game, char posmov[], Tokens temp[], int diceNum, int numberOfSix);
+
+/*
+    Input :
+    @posmov[] the possibility of moving tokens
+    @diceNum the current diceroll
+    @numberOfSix number of six already rolled in the turn before diceNum
+    @numberOfThreads number of threads playing the playouts
+    @isRootParallel every thread keeps its own statistic, merged at the end
+    @limit most playouts of every thread together, 0 means no limit
+    @budget time budget in milliseconds, 0 means no limit
+    Output : Number of token with the highest win rate
+    @total number of playouts played
+*/
+int parallelPlayouts(GameContext *game, char posmov[], int diceNum, int numberOfSix, int numberOfThreads,
+                     bool isRootParallel, long limit, int budget, long *total);
+
+/*
+    Initial State : The playouts of the thread haven't been played
+    Input :
+    @arg the PlayoutWorker of the thread
+    Final State : Playouts are played until the limit or the deadline
+*/
+void *playoutWorker(void *arg);
+
+/*
+    Input :
+    @plays[4] number of playouts of every token
+    @wins[4] number of playouts of every token won by the bot
+    @moves[] tokens that can be moved
+    @numberOfMoves number of tokens that can be moved
+    Output : Token without playouts, otherwise the token with the highest upper
+             confidence bound (UCB1) so the promising moves get more playouts
+*/
+int selectPlayoutMove(long plays[4], long wins[4], int moves[], int numberOfMoves);
+
+/*
+    Input : Same as selectPlayoutMove
+    Output : Token with the highest win rate, the first token if nothing is played
+*/
+int bestWinRate(long plays[4], long wins[4], int moves[], int numberOfMoves);
+
+/*
+    Input :
+    @root colour index of the bot
+    Output : Bit of every colour index that's still playing, other than the bot
+*/
+int playoutRivals(GameContext *game, int root);
+
+/*
+    Input : None
+    Output : Time in milliseconds from an unspecified point, not affected by
+             changes of the system clock
+*/
+long long monotonicMillis();
+
+/*
+    Input :
+    @size size of the memory, a multiple of CACHE_LINE
+    Output : Memory that starts on a cache line, NULL if there's not enough memory
+*/
+void *alignedAlloc(size_t size);
+
+/*
+    Input :
+    @memory memory from alignedAlloc
+    Final State : The memory is freed
+*/
+void alignedFree(void *memory);
+
+/*
+    Initial State : Curses is not used
+    Input :
+    @argc number of arguments after --benchmark
+    @argv[] arguments after --benchmark
+    Output : 0 if the benchmark is done
+    Final State : Playouts per second of Werner for every number of threads
+                  and both modes are printed to the standard output, up to
+                  every hardware thread unless the most threads is given
+*/
+int benchmarkCommand(int argc, char *argv[]);
+
+/*
+    Initial State : Playout state is unknown
+    Final State : Playout has the tokens, the players and the current turn of the game
+*/
+void initPlayout(GameContext *game, Playout *playout);
+
+/*
+    Initial State : A turn is being played in a playout
+    Input :
+    @diceRoll the dice roll to be played
+    @numberOfSix number of six already rolled in the turn before diceRoll
+    @numOfToken the token moved with diceRoll, -1 to choose it randomly
+    Final State : The rest of the turn is played with random moves
+*/
+void playoutTurn(Playout *playout, int diceRoll, int numberOfSix, int numOfToken);
+
+/*
+    Initial State : The turn of the current player in the playout is done
+    Input :
+    @root colour index of the bot
+    @rivals bit of every colour index that has to finish after the bot
+    Output : true if the bot finished before every rival, or is expected to
+             finish first when the playout is cut off after PLAYOUT_ROUNDS
+    Final State : The game is played with random moves until it's decided or cut off
+*/
+bool playGameOut(Playout *playout, int root, int rivals);
+
+/*
+    Input :
+    @colour colour index of the player
+    Output : Expected number of turns the player needs to finish, from the
+             tablebase if it's loaded, otherwise from the progress left.
+             Only compared with other players of the same playout
+*/
+double playoutRaceTurns(Playout *playout, int colour);
+
+/*
+    Input :
+    @colour colour index of the token
+    @progress progress of the token as in PackedGame
+    Output : Board position of the token (1 - 52), 0 if it's in the home base or in the safezone
+*/
+int progressToPosition(int colour, int progress);
+
+/*
+    Input :
+    @progress[4] progress of the four tokens of one colour, in any order
+    Output : Index of the position in the tablebase, the same for every order of the tokens
+    @slot[4] index of the token at every place of the sorted progress
+*/
+int tablebaseIndex(uint8_t progress[4], int slot[4]);
+
+/*
+    Input :
+    @diceNum the dice roll
+    @numberOfSix number of six already rolled in the turn before diceNum
+    Output : Which of the 8 moves of a position is used (0 - 7), a six depends
+             on the sixes before it as the third six doesn't roll again
+*/
+int tablebaseSituation(int diceNum, int numberOfSix);
+
+/*
+    Input :
+    @argc number of arguments after --tablebase
+    @argv[] the file name, TABLEBASE_FILE if there's none
+    Output : 0 if the tablebase is written
+    Final State : Tablebase of every position is solved and written to the file
+*/
+int tablebaseCommand(int argc, char *argv[]);
+
+/*
+    Input :
+    @fileName the tablebase file
+    Output : true if the tablebase is loaded
+    Final State : The file is mapped to memory and used by tablebaseMove
+*/
+bool loadTablebase(char fileName[]);
+
+/*
+    Input :
+    @posmov[] the possibility of moving tokens
+    @diceNum the current diceroll
+    @numberOfSix number of six already rolled in the turn before diceNum
+    Output : Token that finishes in the least expected turns if every token of
+             the current player is in the safezone, otherwise -1
+*/
+int tablebaseMove(GameContext *game, char posmov[], int diceNum, int numberOfSix);
+
+/*
+    Initial State : Lane is empty or its game is over
+    Input :
+    @lane the lane of the game
+    @seed seed of the game
+    Final State : A new game is in the lane, every token in the home base
+*/
+void batchStartGame(BatchGames *batch, int lane, uint64_t seed);
+
+/*
+    Initial State : isRolling is set for the lanes where the colour rolls
+    Input :
+    @colour colour index of the current player of every lane
+    @numberOfPlayers the colours 0 to numberOfPlayers - 1 are playing
+    Final State : One roll is played in every lane that's rolling, isRolling
+                  is kept only for the lanes that rolled a six
+*/
+void batchStep(BatchGames *batch, int colour, int numberOfPlayers);
+
+/*
+    Initial State : It's the turn of the colour in every lane
+    Input :
+    @colour colour index of the current player of every lane
+    @numberOfPlayers the colours 0 to numberOfPlayers - 1 are playing
+    Final State : The turn is played in every lane, the colour gets its place if it has finished
+*/
+void batchTurn(BatchGames *batch, int colour, int numberOfPlayers);
+
+/*
+    Input :
+    @argc number of arguments after --batch
+    @argv[] number of games, number of players and seed
+    Output : 0 if the games are played
+    Final State : Games per second and win rate of every seat of the batch
+                  simulator and of the scalar headless games are printed
+*/
+int batchCommand(int argc, char *argv[]);
+
+/*
+    Initial State : Curses is not started
+    Final State : Curses is started with the colours of the board, the program
+                  exits if the console has no colour
+*/
+void initScreen();
+
+/*
+    Input :
+    @position winning position of the user
+    Output : The score of the player
+    Author : Muhammad Fauzan L.
+*/
+int calculateScore(GameContext *game, int position);
+
+/*
+    Input :
+    @colour colour index of the player
+    @position winning position of the player
+    Output : The score of the player, the same as calculateScore gives the user
+*/
+int playerScore(GameContext *game, int colour, int position);
+
+/*
+    Initial State : Screen is empty
+    Final State : Shows win message
+    Author : Muhammad Fauzan L.
+*/
+void showWin();
+
+/*
+    Initial State : Screen is empty
+    Final State : Shows lose message
+    Author : Muhammad Fauzan L.
+*/
+void showLose();
+
+/*
+    Initial State : Win or lose message is shown
+    Final State : The seed of the game is shown under the message
+    Input :
+    @seed seed of the random stream of the game
+*/
+void showSeed(uint64_t seed);
+
+/*
+    Initial State : User score is known to be a new highscore
+    Final State : User has inputted a name and the score is written to the file
+    Input :
+    @score the new highscore score
+    Author : Muhammad Fauzan L.
+*/
+void newHighScoreMenu(int score);
+
+int main(int argc, char *argv[])
+{
+    int choice[3];
+    uint64_t gameSeed;
+
+    // Keys of the position hash, used by every game
+    initZobrist();
+
+    // Endgame tablebase is only built on request, it's used if it's there
+    if (argc > 1 && strcmp(argv[1], "--tablebase") == 0)
+    {
+        return tablebaseCommand(argc - 2, argv + 2);
+    }
+    loadTablebase(TABLEBASE_FILE);
+
+    // Bot tournament is played without curses
+    if (argc > 1 && strcmp(argv[1], "--tournament") == 0)
+    {
+        return tournamentCommand(argc - 2, argv + 2);
+    }
+
+    // Batch simulator of Jörgen, without curses as well
+    if (argc > 1 && strcmp(argv[1], "--batch") == 0)
+    {
+        return batchCommand(argc - 2, argv + 2);
+    }
+
+    // Simulation for scripts, without curses as well
+    if (argc > 1 && strcmp(argv[1], "--simulate") == 0)
+    {
+        return simulateCommand(argc - 2, argv + 2);
+    }
+
+    // Archive of a simulation, without curses as well
+    if (argc > 1 && strcmp(argv[1], "--read-archive") == 0)
+    {
+        return readArchiveCommand(argc - 2, argv + 2);
+    }
+
+    // Playout benchmark of Werner, without curses as well
+    if (argc > 1 && strcmp(argv[1], "--benchmark") == 0)
+    {
+        return benchmarkCommand(argc - 2, argv + 2);
+    }
+
+    // Animation speed of the game
+    if (!parseSpeedOptions(argc - 1, argv + 1))
+    {
+        return 1;
+    }
+
+    // A replay log is played instead of the game
+    if (replayName != NULL)
+    {
+        return replayCommand(replayName);
+    }
+
+    initScreen();
+
+    // Check for the highscore file
+    if (!isFileExist("highscore.txt"))
+    {
+        // If none found, initalize the file
+        initHighScore();
+    }
+
+    // Show main menu and get the user choice in menu
+    switch (getUserChoiceinMenu())
+    {
+    case 0:
+        /*
+            Play new game here
+            While not gameover, showboard and option box, check who's turn, play
+        */
+        // The seed is shown at the end of the game
+        gameSeed = (uint64_t)time(NULL);
+        seedRandom(&currentGame.rng, gameSeed);
+
+        // Get user choice on how many and what kind of bots
+        showNewGameMenu(&currentGame, choice);
+        initPlayerData(&currentGame, choice);
+
+        clear();
+        // Pause handler using interupt signal from the user
+        signal(SIGINT, pauseHandler);
+
+        // Initialized the board and the option box
+        showOptionBox();
+        initBoard();
+
+        // Draw the board, the tokens and the labels
+        renderBoard(&currentGame);
+
+        startRecording(&currentGame);
+
+        while (1)
+        {
+            // Start the turn
+            aTurn(&currentGame);
+            // Move to the next
+            moveToNextTurn(&currentGame);
+            recordTurn(&currentGame);
+            // Check if gameover
+            if (isGameOver(&currentGame))
+            {
+                break;
+            }
+        }
+
+        stopRecording();
+
+        // Delete the board and option box as it's not used anymore
+        destroyBoard();
+        destroyOptionBox();
+
+        // Remove the handler as it's not used anymore
+        signal(SIGINT, SIG_DFL);
+
+        // Clear out the screen
+        clear();
+        refresh();
+
+        if (isAllBotWin(&currentGame))
+        {
+            /*
+                Show losing screen here
+            */
+            showLose();
+            showSeed(gameSeed);
+            getch();
+        }
+        else
+        {
+            /*
+                Show winning screen
+            */
+            showWin();
+            showSeed(gameSeed);
+
+            // Calculate the high score if player win
+            int score = calculateScore(&currentGame, currentGame.position);
+
+            // If the score is top 10 of the highscore
+            if (isHighScore(score))
+            {
+                newHighScoreMenu(score);
+            }
+            else
+            {
+                mvprintw(8, getMiddleX(stdscr, strlen("Your score is     ")), "Your score is %d", score);
+                mvprintw(9, getMiddleX(stdscr, strlen("Not a new highscore, press anything to exit...")), "Not a new highscore, press anything to exit...");
+                refresh();
+            }
+        }
+
+        getch();
+        break;
+
+    case 1:
+        /*
+            Play resumed game here
+            Check if file exist, check if file empty, load save game into variable, play as usual
+        */
+        clear();
+        if (!isFileExist("currentState.savegame"))
+        {
+            printw("File don't exist, press anything to exit...");
+            getch();
+            exit(6);
+        }
+
+        // Load game save
+        getGameState(&currentGame);
+
+        // Random stream is not part of the save
+        seedRandom(&currentGame.rng, time(NULL));
+
+        // Pause handler using interupt signal from the user
+        signal(SIGINT, pauseHandler);
+
+        // Initialized the board and the option box
+        showOptionBox();
+        initBoard();
+
+        // Draw the board, the tokens and the labels
+        renderBoard(&currentGame);
+
+        startRecording(&currentGame);
+
+        while (!isGameOver(&currentGame))
+        {
+            // Start the turn
+            aTurn(&currentGame);
+            // Move to the next
+            moveToNextTurn(&currentGame);
+            recordTurn(&currentGame);
+        }
+
+        stopRecording();
+
+        // Remove the handler
+        signal(SIGINT, SIG_DFL);
+
+        // Clear out the screen
+        clear();
+        refresh();
+
+        if (isAllBotWin(&currentGame))
+        {
+            /*
+                Show losing screen here
+            */
+            showLose();
+        }
+        else
+        {
+            /*
+                Show winning screen
+            */
+            showWin();
+
+            // Calculate the high score if player win
+            int score = calculateScore(&currentGame, currentGame.position);
+
+            // If the score is top 10 of the highscore
+            if (isHighScore(score))
+            {
+                newHighScoreMenu(score);
+            }
+            else
+            {
+                mvprintw(8, getMiddleX(stdscr, strlen("Your score is     ")), "Your score is %d", score);
+                mvprintw(9, getMiddleX(stdscr, strlen("Not a new highscore, press anything to exit...")), "Not a new highscore, press anything to exit...");
+                refresh();
+            }
+        }
+
+        getch();
+        break;
+
+    case 2:
+        /*
+            Show highscore here
+        */
+        clear();
+
+        showHighScore();
+        break;
+
+    case 3:
+        /*
+            Exit the game here
+            Just do nothing as the endwin and return 0 is right down of this selection
+        */
+        break;
+    }
+
+    // Curses mode end
+    endwin();
+    return 0;
+}
+
+/* Function Body */
+
+void initScreen()
+{
+    // Curses mode intialization
+    initscr();
+
+    // Check for console capabilities
+    if (!has_colors())
+    {
+        printw("No color support on console");
+        getch();
+        exit(1);
+    }
+
+    // Starts out colour mode of curses
+    start_color();
+
+    // Initalize all the color pairs for the board
+    init_pair(BOARD_BLUE, COLOR_WHITE, COLOR_BLUE);
+    init_pair(BOARD_RED, COLOR_WHITE, COLOR_RED);
+    init_pair(BOARD_GREEN, COLOR_WHITE, COLOR_GREEN);
+    init_pair(BOARD_YELLOW, COLOR_WHITE, COLOR_YELLOW);
+    init_pair(BOARD_WHITE, COLOR_BLACK, COLOR_WHITE);
+    init_pair(BOARD_BLACK, COLOR_WHITE, COLOR_BLACK);
+
+    // Set background to black
+    bkgd(COLOR_PAIR(BOARD_BLACK));
+    refresh();
+}
+
+WINDOW *newWindow(int line, int collumns, int starty, int startx)
+{
+    WINDOW *win;
+
+    win = newwin(line, collumns, startx, starty);
+    // wborder(win, 0, 0, 0, 0, 0, 0, 0, 0);
+
+    wrefresh(win);
+    return win;
+}
+
+void drawBoard(CellFrame frame[15][15])
+{
+    int i; // Rows of Board
+    int j; // Collumn of Board
+
+    // Cells that are not coloured stay in the default colour
+    memset(frame, 0, sizeof(CellFrame) * 15 * 15);
+
+    // Blue Corner
+    for (i = 0; i <= 5; i++)
+    {
+        for (j = 0; j <= 5; j++)
+        {
+            if (i == 0 && j == 2)
+            {
+                continue;
+            }
+            else if (i == 0 || i == 5)
+            {
+                frame[i][j].pair = BOARD_BLACK;
+            }
+            else if (j == 0 || j == 5)
+            {
+                frame[i][j].pair = BOARD_BLACK;
+            }
+            else
+            {
+                frame[i][j].pair = BOARD_BLUE;
+            }
+        }
+    }
+
+    // Red Corner
+    for (i = 0; i <= 5; i++)
+    {
+        for (j = 9; j <= 14; j++)
+        {
+            if (i == 0 && j == 11)
+            {
+                continue;
+            }
+            else if (i == 0 || i == 5)
+            {
+                frame[i][j].pair = BOARD_BLACK;
+            }
+            else if (j == 9 || j == 14)
+            {
+                frame[i][j].pair = BOARD_BLACK;
+            }
+            else
+            {
+                frame[i][j].pair = BOARD_RED;
+            }
+        }
+    }
+
+    // Green Corner
+    for (i = 9; i <= 14; i++)
+    {
+        for (j = 9; j <= 14; j++)
+        {
+            if (i == 9 && j == 11)
+            {
+                continue;
+            }
+            else if (i == 9 || i == 14)
+            {
+                frame[i][j].pair = BOARD_BLACK;
+            }
+            else if (j == 9 || j == 14)
+            {
+                frame[i][j].pair = BOARD_BLACK;
+            }
+            else
+            {
+                frame[i][j].pair = BOARD_GREEN;
+            }
+        }
+    }
+
+    // Yellow Corner
+    for (i = 9; i <= 14; i++)
+    {
+        for (j = 0; j <= 5; j++)
+        {
+            if (i == 9 && j == 2)
+            {
+                continue;
+            }
+            else if (i == 9 || i == 14)
+            {
+                frame[i][j].pair = BOARD_BLACK;
+            }
+            else if (j == 0 || j == 5)
+            {
+                frame[i][j].pair = BOARD_BLACK;
+            }
+            else
+            {
+                frame[i][j].pair = BOARD_YELLOW;
+            }
+        }
+    }
+
+    // Line on j = 6
+    for (i = 0; i <= 14; i++)
+    {
+        if (i != 6 && i != 7 && i != 8)
+        {
+            frame[i][6].pair = BOARD_WHITE;
+        }
+    }
+
+    // Line on j = 8
+    for (i = 0; i <= 14; i++)
+    {
+        if (i != 6 && i != 7 && i != 8)
+        {
+            frame[i][8].pair = BOARD_WHITE;
+        }
+    }
+
+    // Two of single blocks on j = 7
+    frame[0][7].pair = BOARD_WHITE;
+
+    frame[14][7].pair = BOARD_WHITE;
+
+    // Line on i = 6
+    for (j = 0; j <= 14; j++)
+    {
+        if (j != 6 && j != 7 && j != 8)
+        {
+            frame[6][j].pair = BOARD_WHITE;
+        }
+    }
+
+    // Line on i = 8
+    for (j = 0; j <= 14; j++)
+    {
+        if (j != 6 && j != 7 && j != 8)
+        {
+            frame[8][j].pair = BOARD_WHITE;
+        }
+    }
+
+    // Two of single blocks on i = 7
+    frame[7][0].pair = BOARD_WHITE;
+
+    frame[7][14].pair = BOARD_WHITE;
+
+    // Blue Safezone
+    for (j = 1; j <= 6; j++)
+    {
+        frame[7][j].pair = BOARD_BLUE;
+    }
+
+    // Red Safezone
+    for (i = 1; i <= 6; i++)
+    {
+        frame[i][7].pair = BOARD_RED;
+    }
+
+    // Green Safezone
+    for (j = 8; j <= 13; j++)
+    {
+        frame[7][j].pair = BOARD_GREEN;
+    }
+
+    // Yellow Safezone
+    for (i = 8; i <= 13; i++)
+    {
+        frame[i][7].pair = BOARD_YELLOW;
+    }
+}
+
+void initBoard()
+{
+    int i;
+    int j;
+
+    // Show the cleared screen first so it's not drawn over the board later
+    refresh();
+
+    // One window for the whole 15 * 15 board starting from (1, 1)
+    board = newWindow(15 * CELL_HEIGHT, 15 * 4, 1, 1);
+
+    for (i = 0; i < 15; i++)
+    {
+        for (j = 0; j < 15; j++)
+        {
+            cellRect[i][j].row = i * CELL_HEIGHT;
+            cellRect[i][j].col = j * 4;
+            cellRect[i][j].width = 4;
+        }
+    }
+
+    // Label cells are 2 cells wide
+    cellRect[0][1].width = 8;
+    cellRect[0][10].width = 8;
+    cellRect[9][1].width = 8;
+    cellRect[9][10].width = 8;
+
+    cellRect[0][2].width = 0;
+    cellRect[0][11].width = 0;
+    cellRect[9][2].width = 0;
+    cellRect[9][11].width = 0;
+
+    // Nothing is drawn yet
+    invalidateBoard();
+}
+
+void renderBoard(GameContext *game)
+{
+    CellFrame frame[15][15]; // The board as it should be on the screen
+    bool isLabelErased;      // The labels are erased together with their cells
+    CellRect *rect;
+    int i;
+    int j;
+    int k;
+
+    drawBoard(frame);
+    drawTokens(game, frame);
+
+    isLabelErased = false;
+
+    for (i = 0; i < 15; i++)
+    {
+        for (j = 0; j < 15; j++)
+        {
+            rect = &cellRect[i][j];
+
+            // These cells are merged into the label cells
+            if (rect->width == 0)
+            {
+                continue;
+            }
+
+            if (frame[i][j].pair == shownFrame[i][j].pair && strcmp(frame[i][j].shown, shownFrame[i][j].shown) == 0)
+            {
+                continue;
+            }
+
+            // Fill the rectangle of the cell with its colour
+            wattrset(board, COLOR_PAIR(frame[i][j].pair));
+            for (k = 0; k < CELL_HEIGHT; k++)
+            {
+                mvwprintw(board, rect->row + k, rect->col, "%*s", rect->width, "");
+            }
+
+            // Tokens that don't fit in the first row goes to the next one
+            for (k = 0; k < CELL_HEIGHT && k * rect->width < (int)strlen(frame[i][j].shown); k++)
+            {
+                mvwaddnstr(board, rect->row + k, rect->col, frame[i][j].shown + k * rect->width, rect->width);
+            }
+
+            if ((i == 0 || i == 9) && (j == 1 || j == 10))
+            {
+                isLabelErased = true;
+            }
+
+            shownFrame[i][j] = frame[i][j];
+        }
+    }
+
+    if (isLabelErased)
+    {
+        showLabel(game);
+    }
+
+    // The whole board is copied to the screen at once
+    wnoutrefresh(board);
+    doupdate();
+}
+
+void invalidateBoard()
+{
+    int i;
+    int j;
+
+    for (i = 0; i < 15; i++)
+    {
+        for (j = 0; j < 15; j++)
+        {
+            // No colour pair is negative so every cell is different
+            shownFrame[i][j].pair = -1;
+        }
+    }
+}
+
+void destroyBoard()
+{
+    // Restore back the window to black
+    wattrset(board, COLOR_PAIR(BOARD_BLACK));
+    wbkgd(board, COLOR_PAIR(BOARD_BLACK));
+
+    // Clear out whatever inside the window
+    werase(board);
+
+    // Update it
+    wrefresh(board);
+
+    // Delete as it's not used anymore
+    delwin(board);
+}
+
+bool hasColour()
+{
+    return has_colors();
+}
+
+int getMiddleX(WINDOW *win, int len)
+{
+    int x;
+    int y;
+    getmaxyx(win, y, x);
+
+    return (x / 2) - (len / 2);
+}
+
+void showLogo()
+{
+    WINDOW *logo;
+    FILE *logo_file;
+    int i;
+    char logo_data[125];
+
+    // As logo is an ASCII art it's easier to print from a file
+    // Open it as read-only
+    logo_file = fopen("logo.txt", "r");
+
+    // File not found or cannot be openned
+    if (logo_file == NULL)
+    {
+        erase();
+
+        printw("Logo file not found / permission problems");
+        getch();
+
+        // Return back the console properties
+        echo();
+        curs_set(1);
+        exit(3);
+    }
+
+    // New widow to put the logo
+    // Horizontally center
+    logo = newWindow(10, 41, getMiddleX(stdscr, 35), 1);
+
+    // Show the logo
+    for (i = 0; i < 9; i++)
+    {
+        if (fgets(logo_data, 125, logo_file) != NULL)
+        {
+            mvwprintw(logo, i, 0, logo_data);
+        }
+        else
+        {
+            // If somehow the file reaches End-Of-File
+            mvwprintw(logo, i, 0, "EOF!");
+        }
+    }
+
+    // Close the file and refresh the screen
+    fclose(logo_file);
+    wrefresh(logo);
+
+    // Delete the window as it's not used anymore
+    delwin(logo);
+}
+
+void showMainMenu(int *choice)
+{
+    WINDOW *mainmenu;
+    int i, highlight = 0, position;
+
+    // Options for the user
+    char options[4][10] = {"New Game", "Resume", "Highscore", "Exit"};
+    char item[9];
+    char ch;
+
+    // Show logo before the menu
+    showLogo();
+
+    // Create new window for the menu
+    mainmenu = newWindow(10, 57, getMiddleX(stdscr, 57), 12);
+    box(mainmenu, 0, 0);
+
+    // Enable keypad mode for key up and down
+    keypad(mainmenu, true);
+
+    // Make sure what has been entered is not shown
+    noecho();
+
+    // Hide the cursor
+    curs_set(0);
+
+    // Loop until has been inputed
+    while (1)
+    {
+        // Show the options
+        for (i = 0; i < 4; i++)
+        {
+            position = getMiddleX(mainmenu, strlen(options[i]));
+
+            // Show the highlighted options with highlights
+            if (i == highlight)
+                wattron(mainmenu, A_REVERSE);
+
+            mvwprintw(mainmenu, i + 1, position, options[i]);
+
+            if (i == highlight)
+                wattroff(mainmenu, A_REVERSE);
+        }
+
+        // Get user input
+        ch = wgetch(mainmenu);
+
+        if (ch == (char)KEY_UP)
+        {
+            highlight--;
+            highlight = (highlight < 0) ? 3 : highlight;
+        }
+        else if (ch == (char)KEY_DOWN)
+        {
+            highlight++;
+            highlight = (highlight > 3) ? 0 : highlight;
+        }
+        else if (ch == 10) // Somehow the usage of KEY_ENTER doesn't work, so char 10 is used instead
+        {
+            *choice = highlight;
+            break;
+        }
+    }
+
+    // After user input clear out the border and window as
+    // it is not used anymore
+    wborder(mainmenu, ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ');
+    delwin(mainmenu);
+}
+
+int getUserChoiceinMenu()
+{
+    int choice;
+
+    // Show the user the menu and get the choice from it
+    showMainMenu(&choice);
+
+    // Clean out the window
+    erase();
+
+    // printw("%d", choice);
+    refresh();
+
+    return choice;
+}
+
+void showNewGameMenu(GameContext *game, int choice[3])
+{
+    WINDOW *botchoice;
+
+    int i, j, highlight = 0, position;
+
+    // Options for bots that user can choose
+    char bot_options[NUMBER_OF_BOT_TYPES][10] = {"Jörgen", "Hans", "Müller", "Klaus", "Franz", "Werner"};
+
+    // Temporary storage for input
+    char item[9];
+    char ch;
+
+    // Initialize the variables
+    for (i = 0; i < 4; i++)
+    {
+        choice[i] = -1;
+    }
+    game->numberOfBots = 0;
+
+    // Show the logo beforehand
+    showLogo();
+
+    // Create new window
+    botchoice = newWindow(10, 57, getMiddleX(stdscr, 57), 12);
+    box(botchoice, 0, 0);
+
+    // Un-hide the cursor
+    curs_set(1);
+
+    // Make sure the user can see what they have inputted before entering it
+    echo();
+
+    wrefresh(botchoice);
+
+    while (1)
+    {
+        mvwprintw(botchoice, 3, 4, "How many bots do you want to play with (1 - 3):");
+        wmove(botchoice, 3, strlen("How many bots do you want to play with (1 - 3):") + 4);
+
+        // Get the user input
+        wscanw(botchoice, "%d", &game->numberOfBots);
+
+        // Check for validity of input
+        if (game->numberOfBots > 0 && game->numberOfBots < 4)
+        {
+            break;
+        }
+
+        wrefresh(botchoice);
+    }
+
+    // Cleared out the box for next stage of menu
+    werase(botchoice);
+
+    // Re-box the window as erase also remove the box from the window
+    box(botchoice, 0, 0);
+
+    // Enable usage of keypad
+    keypad(botchoice, true);
+
+    // Don't show the user input
+    noecho();
+
+    // Hide the cursor
+    curs_set(0);
+
+    // Loops the input stage as much as the user has inputted
+    for (j = 0; j < game->numberOfBots; j++)
+    {
+        // Reset the highlight index each time
+        highlight = 0;
+
+        while (1)
+        {
+            wmove(options, 1, 1);
+            clrtoeol();
+            // Show the current bot number
+            mvwprintw(botchoice, 1, getMiddleX(botchoice, strlen("Bot no. 1")), "Bot no. %d", j + 1);
+
+            // Shows the bot options
+            for (i = 0; i < NUMBER_OF_BOT_TYPES; i++)
+            {
+                // Get the horizontal center for each string
+                position = getMiddleX(botchoice, strlen(bot_options[i]));
+
+                // Highlight it for the selected
+                if (i == highlight)
+                    wattron(botchoice, A_REVERSE);
+
+                mvwprintw(botchoice, i + 2, position, bot_options[i]);
+
+                if (i == highlight)
+                    wattroff(botchoice, A_REVERSE);
+            }
+
+            // Get the user actions
+            ch = wgetch(botchoice);
+
+            if (ch == (char)KEY_UP)
+            {
+                highlight--;
+                highlight = (highlight < 0) ? NUMBER_OF_BOT_TYPES - 1 : highlight;
+            }
+            else if (ch == (char)KEY_DOWN)
+            {
+                highlight++;
+                highlight = (highlight > NUMBER_OF_BOT_TYPES - 1) ? 0 : highlight;
+            }
+            else if (ch == 10)
+            {
+                choice[j] = highlight;
+                break;
+            }
+        }
+    }
+
+    // Remove borders of the box
+    wborder(botchoice, ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ');
+
+    // Remove the window as it's not used anymore
+    delwin(botchoice);
+}
+
+void initHumanPlayerData(GameContext *game, int colour)
+{
+    int i;
+    char col = colourGeometry[colour].col; // Colour of the the player
+
+    game->players[colour].col = col;
+    game->players[colour].comp = false;
+    game->players[colour].move = 0;
+    game->players[colour].kill = 0;
+
+    for (i = 0; i < 4; i++)
+    {
+        game->tokens[colour][i].col = col;
+        game->tokens[colour][i].ind = i;
+        game->tokens[colour][i].pos = 0;
+        game->tokens[colour][i].relpos = 0;
+        game->tokens[colour][i].safe = false;
+    }
+}
+
+void initBotPlayerData(GameContext *game, int botIndexes, int colour)
+{
+    int i;
+    char col = colourGeometry[colour].col;
+    char botIndex;
+
+    switch (botIndexes)
+    {
+    case 0:
+        botIndex = 'j';
+        break;
+
+    case 1:
+        botIndex = 'h';
+        break;
+
+    case 2:
+        botIndex = 'm';
+        break;
+
+    case 3:
+        botIndex = 'k';
+        break;
+
+    case 4:
+        botIndex = 'f';
+        break;
+
+    case 5:
+        botIndex = 'w';
+        break;
+
+    default:
+        break;
+    }
+
+    game->players[colour].col = col;
+    game->players[colour].comp = true;
+    game->players[colour].comptype = botIndex;
+    game->players[colour].move = 0;
+    game->players[colour].kill = 0;
+
+    for (i = 0; i < 4; i++)
+    {
+        game->tokens[colour][i].col = col;
+        game->tokens[colour][i].ind = i;
+        game->tokens[colour][i].pos = 0;
+        game->tokens[colour][i].relpos = 0;
+        game->tokens[colour][i].safe = false;
+    }
+}
+
+void initPlayerData(GameContext *game, int botIndexes[3])
+{
+    int randTemp[4]; // Used for temporary storage of randomized number
+    int i, j;        // Looping variable
+    int temp;
+
+    i = 0;
+
+    // Make sure non-player are known, intializing null players
+    for (i = 0; i < 4; i++)
+    {
+        game->players[i].col = 'n';
+    }
+
+    // Get all uniqe random number
+    i = 0;
+    while (i < 4)
+    {
+        temp = randomRange(&game->rng, 4);
+
+        for (j = 0; j < i; j++)
+        {
+            if (randTemp[j] == temp)
+            {
+                break;
+            }
+        }
+
+        if (j == i)
+        {
+            randTemp[i] = temp;
+            i++;
+        }
+    }
+    initHumanPlayerData(game, randTemp[0]);
+    game->playerIndex[0] = randTemp[0];
+
+    for (i = 0, j = 1; i < game->numberOfBots && j < 4; i++, j++)
+    {
+        initBotPlayerData(game, botIndexes[i], randTemp[j]);
+        game->playerIndex[j] = randTemp[j];
+    }
+
+    buildOccupancy(game);
+}
+
+void getOpponents(GameContext *game, Tokens token, Tokens opponents[], int index)
+{
+    uint16_t found = opponentsAt(game, token, index);
+    int bit, j = 0;
+
+    // Every bit is one token of the opponents
+    for (bit = 0; bit < 16; bit++)
+    {
+        if (found & (1 << bit))
+        {
+            opponents[j] = getColourTokens(game, bit / 4)[bit % 4];
+            j++;
+        }
+    }
+
+    // If none were found return with colour n (null)
+    if (j == 0)
+    {
+        opponents[0].col = 'n';
+    }
+}
+
+int tokenProgress(Tokens token)
+{
+    if (token.safe)
+    {
+        return SAFEZONE_PROGRESS + token.pos;
+    }
+
+    // relpos is 0 in the home base
+    return token.relpos;
+}
+
+Tokens progressToToken(int colour, int numOfToken, int progress)
+{
+    Tokens token;
+
+    token.col = colourGeometry[colour].col;
+    token.ind = numOfToken;
+    token.safe = progress > SAFEZONE_PROGRESS;
+
+    if (token.safe)
+    {
+        token.pos = progress - SAFEZONE_PROGRESS;
+        token.relpos = token.pos;
+    }
+    else if (progress == 0)
+    {
+        token.pos = 0;
+        token.relpos = 0;
+    }
+    else
+    {
+        token.relpos = progress;
+        token.pos = (colourGeometry[colour].start + progress - 2) % 52 + 1;
+    }
+
+    return token;
+}
+
+void packGame(GameContext *game, PackedGame *packed)
+{
+    int colour, i;
+    uint8_t flags;
+
+    for (colour = 0; colour < 4; colour++)
+    {
+        flags = 0;
+
+        if (game->players[colour].col != 'n')
+        {
+            flags |= PACKED_PLAYING;
+        }
+        if (game->playerIndex[game->whosTurn - 1] == colour)
+        {
+            flags |= PACKED_TURN;
+        }
+
+        for (i = 0; i < 4; i++)
+        {
+            packed->token[colour * 4 + i] = tokenProgress(getColourTokens(game, colour)[i]) | flags;
+        }
+    }
+}
+
+void unpackGame(PackedGame *packed, GameContext *game)
+{
+    int colour, i;
+
+    for (colour = 0; colour < 4; colour++)
+    {
+        for (i = 0; i < 4; i++)
+        {
+            getColourTokens(game, colour)[i] = progressToToken(colour, i, packed->token[colour * 4 + i] & PACKED_PROGRESS);
+        }
+
+        // Find the turn of the colour in the turn order
+        if (packed->token[colour * 4] & PACKED_TURN)
+        {
+            for (i = 0; i < game->numberOfBots + 1; i++)
+            {
+                if (game->playerIndex[i] == colour)
+                {
+                    game->whosTurn = i + 1;
+                }
+            }
+        }
+    }
+
+    buildOccupancy(game);
+}
+
+Tokens *getColourTokens(GameContext *game, int colour)
+{
+    return game->tokens[colour];
+}
+
+void buildOccupancy(GameContext *game)
+{
+    int colour, i;
+
+    memset(game->occupant, 0, sizeof(game->occupant));
+    memset(game->ring, 0, sizeof(game->ring));
+    memset(game->lane, 0, sizeof(game->lane));
+
+    for (colour = 0; colour < 4; colour++)
+    {
+        for (i = 0; i < 4; i++)
+        {
+            placeToken(game, colour, i);
+        }
+    }
+
+    game->hash = computeHash(game);
+}
+
+void initZobrist()
+{
+    Random rng;
+    int colour, i, progress;
+
+    seedRandom(&rng, 0x4C75646F);
+
+    for (colour = 0; colour < 4; colour++)
+    {
+        for (i = 0; i < 4; i++)
+        {
+            for (progress = 0; progress <= FINISHED_PROGRESS; progress++)
+            {
+                zobristToken[colour][i][progress] = nextRandom(&rng);
+            }
+        }
+
+        zobristTurn[colour] = nextRandom(&rng);
+    }
+
+    for (i = 0; i < 3; i++)
+    {
+        zobristSixes[i] = nextRandom(&rng);
+    }
+}
+
+uint64_t computeHash(GameContext *game)
+{
+    uint64_t hash = zobristTurn[game->playerIndex[game->whosTurn - 1]];
+    int colour, i;
+
+    for (colour = 0; colour < 4; colour++)
+    {
+        for (i = 0; i < 4; i++)
+        {
+            hash ^= zobristToken[colour][i][tokenProgress(game->tokens[colour][i])];
+        }
+    }
+
+    return hash;
+}
+
+void hashToken(GameContext *game, int colour, int numOfToken)
+{
+    game->hash ^= zobristToken[colour][numOfToken][tokenProgress(game->tokens[colour][numOfToken])];
+}
+
+uint64_t positionHash(GameContext *game, int sixes)
+{
+    return game->hash ^ zobristSixes[sixes];
+}
+
+void placeToken(GameContext *game, int colour, int numOfToken)
+{
+    Tokens *token = &getColourTokens(game, colour)[numOfToken];
+
+    if (token->safe)
+    {
+        game->lane[colour] |= 1 << (token->pos - 1);
+    }
+    // Only tokens on the board, not in the home base
+    else if (token->pos > 0 && token->pos <= 52)
+    {
+        game->occupant[token->pos] |= 1 << (colour * 4 + numOfToken);
+        game->ring[colour] |= 1ULL << (token->pos - 1);
+    }
+}
+
+void liftToken(GameContext *game, int colour, int numOfToken)
+{
+    Tokens *tokens = getColourTokens(game, colour);
+    int i;
+
+    if (tokens[numOfToken].safe)
+    {
+        game->lane[colour] &= ~(1 << (tokens[numOfToken].pos - 1));
+
+        // Other tokens might still be on the same safezone position
+        for (i = 0; i < 4; i++)
+        {
+            if (i != numOfToken && tokens[i].safe && tokens[i].pos == tokens[numOfToken].pos)
+            {
+                game->lane[colour] |= 1 << (tokens[i].pos - 1);
+            }
+        }
+    }
+    else if (tokens[numOfToken].pos > 0 && tokens[numOfToken].pos <= 52)
+    {
+        game->occupant[tokens[numOfToken].pos] &= ~(1 << (colour * 4 + numOfToken));
+
+        // Only clear the bitboard if there's no other token of the colour left there
+        if ((game->occupant[tokens[numOfToken].pos] & (0xF << (colour * 4))) == 0)
+        {
+            game->ring[colour] &= ~(1ULL << (tokens[numOfToken].pos - 1));
+        }
+    }
+}
+
+uint16_t opponentsAt(GameContext *game, Tokens token, int index)
+{
+    // Come back around the board
+    while (index > 52)
+    {
+        index -= 52;
+    }
+    while (index <= 0)
+    {
+        index += 52;
+    }
+
+    // Remove the tokens with the same colour
+    return game->occupant[index] & ~(0xF << (whosOpponents(token.col) * 4));
+}
+
+uint64_t opponentsRing(GameContext *game, Tokens token)
+{
+    int own = whosOpponents(token.col);
+    uint64_t ring = 0;
+    int i;
+
+    // A cell shared with an own token still holds the opponents token
+    for (i = 0; i < 4; i++)
+    {
+        if (i != own)
+        {
+            ring |= game->ring[i];
+        }
+    }
+
+    return ring;
+}
+
+uint64_t ringWindow(uint64_t ring, int index, int length)
+{
+    int shift = (index - 1) % 52;
+
+    // Come back around the board
+    if (shift < 0)
+    {
+        shift += 52;
+    }
+
+    // Rotate the 52 positions so index is at bit 0
+    if (shift != 0)
+    {
+        ring = ((ring >> shift) | (ring << (52 - shift))) & RING_MASK;
+    }
+
+    return ring & ((1ULL << length) - 1);
+}
+
+bool isTransitionToSafezone(Tokens token, int diceroll)
+{
+    return (token.relpos + diceroll) > 51;
+}
+
+void waitForEvent(int event)
+{
+    int delay = paceOverride[event] >= 0 ? paceOverride[event] : paceDelay[animationSpeed][event];
+
+    if (delay == 0)
+    {
+        return;
+    }
+
+    // Wait for a key with a timeout, so any key skips the rest of the wait
+    noecho();
+    wtimeout(options, delay);
+    wgetch(options);
+    wtimeout(options, -1);
+}
+
+bool parseSpeedOptions(int argc, char *argv[])
+{
+    char speedName[3][8] = {"instant", "fast", "normal"};
+    char *value;
+    int i, j;
+    bool isValid;
+
+    for (i = 0; i < argc; i++)
+    {
+        isValid = false;
+
+        if (strcmp(argv[i], "--fast-forward") == 0)
+        {
+            isFastForward = true;
+            isValid = true;
+        }
+        else if (strcmp(argv[i], "--root-parallel") == 0)
+        {
+            isRootParallel = true;
+            isValid = true;
+        }
+        else if (strcmp(argv[i], "--watch") == 0)
+        {
+            isWatching = true;
+            isValid = true;
+        }
+        else if (strcmp(argv[i], "--view") == 0)
+        {
+            isViewing = true;
+            isValid = true;
+        }
+        else if (strcmp(argv[i], "--record") == 0 && i + 1 < argc)
+        {
+            i++;
+            recordName = argv[i];
+            isValid = true;
+        }
+        else if (strcmp(argv[i], "--replay") == 0 && i + 1 < argc)
+        {
+            i++;
+            replayName = argv[i];
+            isValid = true;
+        }
+        else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc)
+        {
+            i++;
+            playoutThreads = atoi(argv[i]);
+            isValid = isdigit(argv[i][0]) && playoutThreads <= MAX_THREAD;
+        }
+        else if (strcmp(argv[i], "--speed") == 0 && i + 1 < argc)
+        {
+            i++;
+            for (j = 0; j < 3; j++)
+            {
+                if (strcmp(argv[i], speedName[j]) == 0)
+                {
+                    animationSpeed = j;
+                    isValid = true;
+                }
+            }
+        }
+        else if (strcmp(argv[i], "--delay") == 0 && i + 1 < argc)
+        {
+            // Written as event=milliseconds
+            i++;
+            value = strchr(argv[i], '=');
+            for (j = 0; j < NUMBER_OF_PACE && value != NULL; j++)
+            {
+                if (strncmp(argv[i], paceName[j], value - argv[i]) == 0 && strlen(paceName[j]) == (size_t)(value - argv[i]) && isdigit(value[1]))
+                {
+                    paceOverride[j] = atoi(value + 1);
+                    isValid = true;
+                }
+            }
+        }
+
+        if (!isValid)
+        {
+            printf("Usage : ludo [--fast-forward] [--speed instant|fast|normal] [--delay <event>=<milliseconds>]...\n");
+            printf("             [--threads <threads of Werner>] [--root-parallel]\n");
+            printf("             [--record <replay log>] [--replay <replay log> [--watch | --view]]\n");
+            printf("Events : turn, move, suit, result, safezone\n");
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool isFileExist(char fileName[])
+{
+// Different syntax of access on widows
+#ifdef _WIN32
+    return (_access(fileName, F_OK) != -1);
+#else
+    return (access(fileName, F_OK) != -1);
+#endif
+}
+
+void seedRandom(Random *rng, uint64_t seed)
+{
+    rng->state = seed;
+}
+
+uint64_t nextRandom(Random *rng)
+{
+    uint64_t z;
+
+    // SplitMix64, see Steele, Lea and Flood "Fast Splittable Pseudorandom Number Generators"
+    rng->state += 0x9E3779B97F4A7C15ULL;
+    z = rng->state;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+int randomRange(Random *rng, int n)
+{
+    // Multiply the upper 32 bits instead of using modulo, so it's not biased towards small numbers
+    return (int)(((nextRandom(rng) >> 32) * (uint64_t)n) >> 32);
+}
+
+uint64_t splitSeed(uint64_t seed, uint64_t index)
+{
+    Random rng;
+
+    // Every index starts at a different point, then mixed so close indexes aren't correlated
+    seedRandom(&rng, seed + index * 0xD1B54A32D192ED03ULL);
+    return nextRandom(&rng);
+}
+
+int RollADice(Random *rng)
+{
+    return randomRange(rng, 6) + 1;
+}
+
+Tokens getTokens(GameContext *game, int i)
+{
+    return game->tokens[game->playerIndex[game->whosTurn - 1]][i];
+}
+
+void moveToNextTurn(GameContext *game)
+{
+    game->hash ^= zobristTurn[game->playerIndex[game->whosTurn - 1]];
+
+    game->count++;
+    game->whosTurn = game->count % (game->numberOfBots + 1) + 1;
+
+    game->hash ^= zobristTurn[game->playerIndex[game->whosTurn - 1]];
+}
+
+void moveToken(GameContext *game, int diceNum, Tokens temp, char posmov, int numOfToken)
+{
+    Tokens opponents[4]; //to storage the opponents
+    int whosWin = 0;     // Storage to show who won the suit
+
+    getMoveOpponents(game, diceNum, temp, posmov, opponents);
+
+    if (posmov == 'o')
+    {
+        clearOptionBox();
+        mvwprintw(options, 1, 1, "Token %c enter the board", tokenShown(numOfToken));
+        wrefresh(options);
+        waitForEvent(PACE_MOVE);
+    }
+
+    //check if there is opponents with modul isThere opponents
+    if (isCapture(temp, opponents))
+    {
+        //initialize the index of opponent
+        int op = whosOpponents(opponents[0].col);
+        int choice, opChoice; //choice is choosen by player whose take turn and opChoice is choosen by opponents
+
+        do
+        {
+            // Clear out the option box
+            clearOptionBox();
+
+            if (!game->players[game->playerIndex[game->whosTurn - 1]].comp && game->players[op].comp) //if whos take turn is user and opponents is bot
+            {
+                // Get user input on suit menu
+                suitMenu(&choice);
+                // Do random suit for the bot
+                opChoice = suitRandom(&game->rng);
+            }
+            else if (game->players[game->playerIndex[game->whosTurn - 1]].comp && !(game->players[op].comp)) //if whos take turn is bot and opponents is user
+            {
+                choice = suitRandom(&game->rng);
+                suitMenu(&opChoice);
+            }
+            else if (game->players[game->playerIndex[game->whosTurn - 1]].comp && game->players[op].comp) //if both of whos take turn and opponents is bot
+            {
+                choice = suitRandom(&game->rng);
+                waitForEvent(PACE_SUIT);
+                opChoice = suitRandom(&game->rng);
+            }
+
+            recordEvent(REPLAY_SUIT, choice);
+            recordEvent(REPLAY_SUIT, opChoice);
+
+            // Check who won
+            whosWin = suitCheck(choice, opChoice);
+
+            if (whosWin == 0)
+            {
+                clearOptionBox();
+                if ((!game->players[game->playerIndex[game->whosTurn - 1]].comp) || !(game->players[op].comp))
+                {
+                    printToOptionBox("A draw!", 1, 1);
+                    waitForEvent(PACE_RESULT);
+                }
+            }
+
+        } while (whosWin == 0);
+
+        clearOptionBox();
+        if (!game->players[game->playerIndex[game->whosTurn - 1]].comp && game->players[op].comp)
+        {
+            printToOptionBox(whosWin == 1 ? "You've won!" : "You've lost!", 1, 1);
+        }
+        else if (game->players[game->playerIndex[game->whosTurn - 1]].comp && !(game->players[op].comp))
+        {
+            printToOptionBox(whosWin == 1 ? "You've lost!" : "You've won!", 1, 1);
+        }
+        waitForEvent(PACE_RESULT);
+    }
+
+    //if win then token moveForward opponents moveToHome and vice versa
+    applyMove(game, diceNum, temp, posmov, numOfToken, opponents, whosWin);
+
+    if (posmov == 'm' && !isCapture(temp, opponents))
+    {
+        clearOptionBox();
+        if (isTransitionToSafezone(temp, diceNum))
+        {
+            mvwprintw(options, 1, 1, "Token %c move %d step to safe zone", tokenShown(numOfToken), diceNum);
+            wrefresh(options);
+            waitForEvent(PACE_SAFEZONE);
+        }
+        else
+        {
+            mvwprintw(options, 1, 1, "Token %c move %d step to board no-%d", tokenShown(numOfToken), diceNum, temp.pos + diceNum);
+            wrefresh(options);
+            waitForEvent(PACE_MOVE);
+        }
+    }
+
+    // End the turn
+}
+
+void getMoveOpponents(GameContext *game, int diceNum, Tokens temp, char posmov, Tokens opponents[])
+{
+    int i;
+
+    for (i = 0; i < 4; i++)
+    {
+        opponents[i].col = 'n';
+    }
+
+    if (posmov == 'm')
+    {
+        // There's no opponents in the safe zone
+        if (!isTransitionToSafezone(temp, diceNum) && !temp.safe)
+        {
+            getOpponents(game, temp, opponents, temp.pos + diceNum);
+        }
+    }
+    else if (posmov == 'o')
+    {
+        getOpponents(game, temp, opponents, colourGeometry[game->playerIndex[game->whosTurn - 1]].start);
+    }
+}
+
+bool isCapture(Tokens temp, Tokens opponents[])
+{
+    return (opponents[0].col != temp.col) && (opponents[0].col != 'n');
+}
+
+void applyMove(GameContext *game, int diceNum, Tokens temp, char posmov, int numOfToken, Tokens opponents[], int whosWin)
+{
+    int i;
+
+    if (isCapture(temp, opponents) && whosWin != 1)
+    {
+        // The player that take turn lost the suit, add the kill to the opponents
+        game->players[whosOpponents(opponents[0].col)].kill++;
+        toHomeBase(game, numOfToken, game->playerIndex[game->whosTurn - 1] + 1);
+    }
+    else
+    {
+        if (posmov == 'm')
+        {
+            //check if the token can move to safe zone or not
+            if (isTransitionToSafezone(temp, diceNum))
+            {
+                moveToSafeZone(game, numOfToken, diceNum);
+            }
+            else
+            {
+                moveForward(game, diceNum, numOfToken);
+            }
+        }
+        else if (posmov == 'o')
+        {
+            outFromHomeBase(game, numOfToken);
+        }
+
+        if (isCapture(temp, opponents))
+        {
+            // Add the kill and send the opponents back to their home base
+            game->players[game->playerIndex[game->whosTurn - 1]].kill++;
+            for (i = 0; i < 4; i++)
+            {
+                if (opponents[i].col != 'n')
+                {
+                    toHomeBase(game, opponents[i].ind, whosOpponents(opponents[0].col) + 1);
+                }
+            }
+        }
+    }
+
+    // Add number of move
+    switch (temp.col)
+    {
+    case 'r':
+        game->players[0].move++;
+        break;
+
+    case 'g':
+        game->players[1].move++;
+        break;
+
+    case 'y':
+        game->players[2].move++;
+        break;
+
+    case 'b':
+        game->players[3].move++;
+        break;
+    }
+
+    // If the bot is complete, the player rank will go down
+    if (isItWin(game, game->playerIndex[game->whosTurn - 1]) && game->players[game->playerIndex[game->whosTurn - 1]].comp)
+    {
+        game->position++;
+    }
+}
+
+int generateMoves(GameContext *game, int diceNum, Move moves[4])
+{
+    int colour = game->playerIndex[game->whosTurn - 1];
+    Tokens opponents[4];
+    Tokens token;
+    int numberOfMoves = 0;
+    int i;
+
+    for (i = 0; i < 4; i++)
+    {
+        token = game->tokens[colour][i];
+        moves[numberOfMoves].action = possibleMove(diceNum, token.pos, token.safe);
+
+        if (moves[numberOfMoves].action == 's')
+        {
+            continue;
+        }
+
+        // Same destination as outFromHomeBase, moveForward and moveToSafeZone
+        if (moves[numberOfMoves].action == 'o')
+        {
+            moves[numberOfMoves].destination = colourGeometry[colour].start;
+            moves[numberOfMoves].safe = false;
+        }
+        else if (token.safe)
+        {
+            moves[numberOfMoves].destination = token.pos + diceNum;
+            moves[numberOfMoves].safe = true;
+        }
+        else if (isTransitionToSafezone(token, diceNum))
+        {
+            moves[numberOfMoves].destination = token.pos + diceNum - colourGeometry[colour].safezoneEntry;
+            moves[numberOfMoves].safe = true;
+        }
+        else
+        {
+            moves[numberOfMoves].destination = (token.pos + diceNum - 1) % 52 + 1;
+            moves[numberOfMoves].safe = false;
+        }
+
+        getMoveOpponents(game, diceNum, token, moves[numberOfMoves].action, opponents);
+        moves[numberOfMoves].isCapture = isCapture(token, opponents);
+        moves[numberOfMoves].token = i;
+        numberOfMoves++;
+    }
+
+    return numberOfMoves;
+}
+
+void playMove(GameContext *game, int diceNum, Move *move, int whosWin)
+{
+    Tokens opponents[4];
+    Tokens token = getTokens(game, move->token);
+
+    getMoveOpponents(game, diceNum, token, move->action, opponents);
+    applyMove(game, diceNum, token, move->action, move->token, opponents, whosWin);
+}
+
+int suitBotVsBot(Random *rng)
+{
+    int whosWin;
+
+    // Keep playing until it's not a draw
+    do
+    {
+        whosWin = suitCheck(suitRandom(rng), suitRandom(rng));
+    } while (whosWin == 0);
+
+    return whosWin;
+}
+
+int botChooseToken(GameContext *game, char posmov[], Tokens temp[], int diceNum, int numberOfSix)
+{
+    switch (game->players[game->playerIndex[game->whosTurn - 1]].comptype)
+    {
+    case 'j':
+        return botJorgen(game, posmov, temp);
+
+    case 'h':
+        return botHans(game, posmov, temp, diceNum);
+
+    case 'm':
+        return botMuller(game, posmov, temp, diceNum);
+
+    case 'k':
+        return botKlaus(game, posmov, temp, diceNum, numberOfSix);
+
+    case 'f':
+        return botFranz(game, posmov, temp, diceNum, numberOfSix);
+
+    case 'w':
+        return botWerner(game, posmov, temp, diceNum, numberOfSix);
+
+    default:
+        return -1;
+    }
+}
+
+void headlessTurn(GameContext *game, BitStream *bits)
+{
+    char posmov[4];      // Storage for possible move
+    Tokens temp[4];      // Temporary token storage for the current player
+    Tokens opponents[4]; // Opponents on the destination of the moved token
+    int diceRoll;        // Temporary storage for diceroll
+    int numberOfSix = 0; // Count the number of the six in the dice roll
+    int numOfToken;      // Number of token that's going to be moved
+    int whosWin;         // Result of the suit if there's any
+    int tempcount;       // Counting the possibilities of stuck
+    int i;               // Looping
+
+    diceRoll = RollADice(&game->rng);
+
+    if (bits != NULL)
+    {
+        writeBits(bits, diceRoll, ARCHIVE_DICE_BITS);
+    }
+
+    while (numberOfSix < 3)
+    {
+        tempcount = 0;
+
+        for (i = 0; i < 4; i++)
+        {
+            temp[i] = getTokens(game, i);
+            posmov[i] = possibleMove(diceRoll, temp[i].pos, temp[i].safe);
+
+            if (posmov[i] == 's')
+                tempcount++;
+        }
+
+        // No tokens can be moved, the turn is over
+        if (tempcount == 4)
+        {
+            break;
+        }
+
+        numOfToken = botChooseToken(game, posmov, temp, diceRoll, numberOfSix);
+
+        getMoveOpponents(game, diceRoll, temp[numOfToken], posmov[numOfToken], opponents);
+        whosWin = isCapture(temp[numOfToken], opponents) ? suitBotVsBot(&game->rng) : 0;
+
+        // Only the outcome of the suit is archived, not the draws before it
+        if (bits != NULL)
+        {
+            writeBits(bits, numOfToken, ARCHIVE_TOKEN_BITS);
+
+            if (isCapture(temp[numOfToken], opponents))
+            {
+                writeBits(bits, whosWin == 1, ARCHIVE_SUIT_BITS);
+            }
+        }
+        applyMove(game, diceRoll, temp[numOfToken], posmov[numOfToken], numOfToken, opponents, whosWin);
+
+        if (diceRoll == 6)
+        {
+            numberOfSix++;
+            diceRoll = RollADice(&game->rng);
+
+            // The roll after the third six is not played
+            if (bits != NULL && numberOfSix < 3)
+            {
+                writeBits(bits, diceRoll, ARCHIVE_DICE_BITS);
+            }
+        }
+        else
+        {
+            break;
+        }
+    }
+}
+
+void fastForwardTurn(GameContext *game, char summary[])
+{
+    char colourName[4][7] = {"Red", "Green", "Yellow", "Blue"};
+    char step[SUMMARY_LENGTH]; // Summary of one move
+    char posmov[4];            // Storage for possible move
+    Tokens temp[4];            // Temporary token storage for the current player
+    Tokens opponents[4];       // Opponents on the destination of the moved token
+    Tokens moved;              // The token after it's moved
+    int diceRoll;              // Temporary storage for diceroll
+    int numberOfSix = 0;       // Count the number of the six in the dice roll
+    int numOfToken;            // Number of token that's going to be moved
+    int whosWin;               // Result of the suit if there's any
+    int choice, opChoice;      // Suit choices of the bots
+    int tempcount;             // Counting the possibilities of stuck
+    int i;                     // Looping
+
+    sprintf(summary, "%s :", colourName[game->playerIndex[game->whosTurn - 1]]);
+
+    diceRoll = RollADice(&game->rng);
+    recordEvent(REPLAY_DICE, diceRoll);
+
+    while (numberOfSix < 3)
+    {
+        tempcount = 0;
+
+        for (i = 0; i < 4; i++)
+        {
+            temp[i] = getTokens(game, i);
+            posmov[i] = possibleMove(diceRoll, temp[i].pos, temp[i].safe);
+
+            if (posmov[i] == 's')
+                tempcount++;
+        }
+
+        // No tokens can be moved, the turn is over
+        if (tempcount == 4)
+        {
+            sprintf(step, " %d -", diceRoll);
+            strncat(summary, step, SUMMARY_LENGTH - 1 - strlen(summary));
+            break;
+        }
+
+        numOfToken = botChooseToken(game, posmov, temp, diceRoll, numberOfSix);
+        recordEvent(REPLAY_TOKEN, numOfToken);
+
+        getMoveOpponents(game, diceRoll, temp[numOfToken], posmov[numOfToken], opponents);
+
+        if (isCapture(temp[numOfToken], opponents) && !game->players[whosOpponents(opponents[0].col)].comp)
+        {
+            // The human has to play the suit, so it's played on the screen
+            renderBoard(game);
+            moveToken(game, diceRoll, temp[numOfToken], posmov[numOfToken], numOfToken);
+        }
+        else
+        {
+            // Same as suitBotVsBot, every choice is recorded
+            whosWin = 0;
+            while (isCapture(temp[numOfToken], opponents) && whosWin == 0)
+            {
+                choice = suitRandom(&game->rng);
+                opChoice = suitRandom(&game->rng);
+                recordEvent(REPLAY_SUIT, choice);
+                recordEvent(REPLAY_SUIT, opChoice);
+                whosWin = suitCheck(choice, opChoice);
+            }
+            applyMove(game, diceRoll, temp[numOfToken], posmov[numOfToken], numOfToken, opponents, whosWin);
+        }
+
+        moved = getTokens(game, numOfToken);
+
+        if (moved.pos == 0)
+        {
+            // Lost the suit
+            sprintf(step, " %d %c lost to %s", diceRoll, tokenShown(numOfToken), colourName[whosOpponents(opponents[0].col)]);
+        }
+        else if (posmov[numOfToken] == 'o')
+        {
+            sprintf(step, " %d %c out", diceRoll, tokenShown(numOfToken));
+        }
+        else if (moved.safe)
+        {
+            sprintf(step, " %d %c safe %d", diceRoll, tokenShown(numOfToken), moved.pos);
+        }
+        else
+        {
+            sprintf(step, " %d %c to %d", diceRoll, tokenShown(numOfToken), moved.pos);
+        }
+        strncat(summary, step, SUMMARY_LENGTH - 1 - strlen(summary));
+
+        if (isCapture(temp[numOfToken], opponents) && moved.pos != 0)
+        {
+            sprintf(step, " x %s", colourName[whosOpponents(opponents[0].col)]);
+            strncat(summary, step, SUMMARY_LENGTH - 1 - strlen(summary));
+        }
+
+        if (diceRoll == 6)
+        {
+            numberOfSix++;
+            diceRoll = RollADice(&game->rng);
+            // The roll after the third six is not played
+            if (numberOfSix < 3)
+            {
+                recordEvent(REPLAY_DICE, diceRoll);
+            }
+        }
+        else
+        {
+            break;
+        }
+    }
+}
+
+bool isHeadlessGameOver(GameContext *game)
+{
+    int notFinished = 0; // Number of players that still haven't finished
+    int i;
+
+    for (i = 0; i < game->numberOfBots + 1; i++)
+    {
+        if (!isItWin(game, game->playerIndex[i]))
+        {
+            notFinished++;
+        }
+    }
+
+    return notFinished <= 1;
+}
+
+void initHeadlessPlayerData(GameContext *game, int botIndexes[4], uint64_t seed)
+{
+    int i;
+
+    // Tokens of the colours that are not playing stay at zero, as they would in a new process
+    memset(game, 0, sizeof(GameContext));
+    seedRandom(&game->rng, seed);
+
+    // Every turn loops over numberOfBots + 1 players, as there's no human
+    // player here the first one is a bot as well
+    game->numberOfBots = -1;
+    game->whosTurn = 1;
+    game->count = 0;
+    game->position = 1;
+
+    for (i = 0; i < 4; i++)
+    {
+        game->players[i].col = 'n';
+
+        if (botIndexes[i] != -1)
+        {
+            initBotPlayerData(game, botIndexes[i], i);
+            game->numberOfBots++;
+            game->playerIndex[game->numberOfBots] = i;
+        }
+    }
+
+    buildOccupancy(game);
+}
+
+void playHeadlessGame(GameContext *game, int rank[4], BitStream *bits)
+{
+    int place = 1; // Next finishing place
+    int i;
+
+    for (i = 0; i < 4; i++)
+    {
+        rank[i] = 0;
+    }
+
+    while (!isHeadlessGameOver(game) && game->count < MAX_HEADLESS_TURN)
+    {
+        headlessTurn(game, bits);
+        rankHeadlessTurn(game, rank, &place);
+        moveToNextTurn(game);
+    }
+
+    rankLastPlayer(game, rank, place);
+}
+
+void rankHeadlessTurn(GameContext *game, int rank[4], int *place)
+{
+    // Rank the player that have just finished
+    if (rank[game->playerIndex[game->whosTurn - 1]] == 0 && isItWin(game, game->playerIndex[game->whosTurn - 1]))
+    {
+        rank[game->playerIndex[game->whosTurn - 1]] = *place;
+        (*place)++;
+    }
+}
+
+void rankLastPlayer(GameContext *game, int rank[4], int place)
+{
+    int i;
+
+    // The last player standing takes the last place
+    if (isHeadlessGameOver(game))
+    {
+        for (i = 0; i < game->numberOfBots + 1; i++)
+        {
+            if (rank[game->playerIndex[i]] == 0)
+            {
+                rank[game->playerIndex[i]] = place;
+            }
+        }
+    }
+}
+
+bool parseLineup(char text[], int lineup[4], int *numberOfSeats)
+{
+    int i;
+
+    *numberOfSeats = 0;
+
+    for (i = 0; text[i] != '\0'; i++)
+    {
+        // Bots are separated by comma
+        if (text[i] == ',')
+        {
+            continue;
+        }
+
+        if (*numberOfSeats == 4)
+        {
+            return false;
+        }
+
+        switch (tolower(text[i]))
+        {
+        case 'j':
+            lineup[*numberOfSeats] = 0;
+            break;
+
+        case 'h':
+            lineup[*numberOfSeats] = 1;
+            break;
+
+        case 'm':
+            lineup[*numberOfSeats] = 2;
+            break;
+
+        case 'k':
+            lineup[*numberOfSeats] = 3;
+            break;
+
+        case 'f':
+            lineup[*numberOfSeats] = 4;
+            break;
+
+        case 'w':
+            lineup[*numberOfSeats] = 5;
+            break;
+
+        default:
+            return false;
+        }
+
+        (*numberOfSeats)++;
+    }
+
+    return *numberOfSeats >= 2;
+}
+
+int getNumberOfThreads()
+{
+    int threads;
+
+// Different way to get the number of processors on windows
+#ifdef _WIN32
+    SYSTEM_INFO info;
+
+    GetSystemInfo(&info);
+    threads = info.dwNumberOfProcessors;
+#else
+    threads = sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+
+    if (threads < 1)
+    {
+        threads = 1;
+    }
+    else if (threads > MAX_THREAD)
+    {
+        threads = MAX_THREAD;
+    }
+
+    return threads;
+}
+
+void playTournamentGame(Tournament *tournament, int gameNumber, int thread)
+{
+    GameContext game;       // Every game has its own state
+    BitStream *bits = NULL; // Bits of the game if it's archived
+    int botIndexes[4];      // Bot of every colour
+    int rank[4];            // Finishing place of every colour
+
+    lineupColours(tournament->lineup, tournament->numberOfSeats, gameNumber, botIndexes);
+
+    if (tournament->archive != NULL)
+    {
+        bits = startArchiveGame(tournament->archive, thread);
+    }
+
+    initHeadlessPlayerData(&game, botIndexes, splitSeed(tournament->seed, gameNumber));
+    playHeadlessGame(&game, rank, bits);
+
+    if (bits != NULL)
+    {
+        addArchiveGame(tournament->archive, thread, gameNumber, game.count);
+    }
+
+    addTournamentGame(tournament, &game, gameNumber, thread, rank);
+}
+
+void lineupColours(int lineup[4], int numberOfSeats, int gameNumber, int botIndexes[4])
+{
+    int seat, colour;
+
+    for (colour = 0; colour < 4; colour++)
+    {
+        botIndexes[colour] = -1;
+    }
+
+    // Rotate the colours so every seat plays every colour evenly
+    for (seat = 0; seat < numberOfSeats; seat++)
+    {
+        botIndexes[(seat + gameNumber) % 4] = lineup[seat];
+    }
+}
+
+void addTournamentGame(Tournament *tournament, GameContext *game, int gameNumber, int thread, int rank[4])
+{
+    int seat, colour;
+
+    for (seat = 0; seat < tournament->numberOfSeats; seat++)
+    {
+        colour = (seat + gameNumber) % 4;
+
+        addGameStats(&tournament->stats[thread][tournament->lineup[seat]], game, colour, rank[colour]);
+        addGameStats(&tournament->seatStats[thread][seat], game, colour, rank[colour]);
+        addGameStats(&tournament->colourStats[thread][colour], game, colour, rank[colour]);
+    }
+}
+
+void addGameStats(BotStats *stats, GameContext *game, int colour, int rank)
+{
+    int score = playerScore(game, colour, rank);
+    int bucket = (score - LOWEST_SCORE) / SCORE_BUCKET;
+
+    if (stats->games == 0 || score < stats->minScore)
+    {
+        stats->minScore = score;
+    }
+    if (stats->games == 0 || score > stats->maxScore)
+    {
+        stats->maxScore = score;
+    }
+
+    stats->games++;
+    stats->kill += game->players[colour].kill;
+    stats->move += game->players[colour].move;
+    stats->turns += game->count;
+    stats->score += score;
+
+    if (rank == 0)
+    {
+        stats->unfinished++;
+    }
+    else
+    {
+        stats->place[rank - 1]++;
+    }
+
+    // Scores outside of the distribution are counted at its ends
+    if (score < LOWEST_SCORE)
+    {
+        bucket = 0;
+    }
+    else if (bucket >= SCORE_BUCKETS)
+    {
+        bucket = SCORE_BUCKETS - 1;
+    }
+    stats->scores[bucket]++;
+}
+
+void mergeBotStats(BotStats *total, BotStats *stats)
+{
+    int i;
+
+    if (stats->games == 0)
+    {
+        return;
+    }
+
+    if (total->games == 0 || stats->minScore < total->minScore)
+    {
+        total->minScore = stats->minScore;
+    }
+    if (total->games == 0 || stats->maxScore > total->maxScore)
+    {
+        total->maxScore = stats->maxScore;
+    }
+
+    total->games += stats->games;
+    for (i = 0; i < 4; i++)
+    {
+        total->place[i] += stats->place[i];
+    }
+    total->unfinished += stats->unfinished;
+    total->kill += stats->kill;
+    total->move += stats->move;
+    total->turns += stats->turns;
+    total->score += stats->score;
+    for (i = 0; i < SCORE_BUCKETS; i++)
+    {
+        total->scores[i] += stats->scores[i];
+    }
+}
+
+bool takeGame(GameQueue *queue, int *gameNumber)
+{
+    bool found = false;
+
+    pthread_mutex_lock(&queue->lock);
+
+    if (queue->begin < queue->end)
+    {
+        *gameNumber = queue->begin;
+        queue->begin++;
+        found = true;
+    }
+
+    pthread_mutex_unlock(&queue->lock);
+
+    return found;
+}
+
+bool stealGames(Tournament *tournament, int thief)
+{
+    GameQueue *victim;
+    int begin, end;
+    int i;
+
+    // Look at every other queue, starting from the next thread
+    for (i = 1; i < tournament->numberOfThreads; i++)
+    {
+        victim = &tournament->queue[(thief + i) % tournament->numberOfThreads];
+
+        pthread_mutex_lock(&victim->lock);
+
+        // Take the back half of the games that are left, the owner keeps the front
+        end = victim->end;
+        begin = end - (victim->end - victim->begin + 1) / 2;
+        victim->end = begin;
+
+        pthread_mutex_unlock(&victim->lock);
+
+        if (begin < end)
+        {
+            // Only one lock is held at a time, so threads stealing from each other can't deadlock
+            pthread_mutex_lock(&tournament->queue[thief].lock);
+            tournament->queue[thief].begin = begin;
+            tournament->queue[thief].end = end;
+            pthread_mutex_unlock(&tournament->queue[thief].lock);
+
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void *tournamentWorker(void *arg)
+{
+    TournamentWorker *worker = (TournamentWorker *)arg;
+    Tournament *tournament = worker->tournament;
+    int gameNumber;
+
+    while (1)
+    {
+        if (takeGame(&tournament->queue[worker->id], &gameNumber))
+        {
+            playTournamentGame(tournament, gameNumber, worker->id);
+        }
+        else if (!stealGames(tournament, worker->id))
+        {
+            // No games left anywhere
+            break;
+        }
+    }
+
+    return NULL;
+}
+
+void runTournament(Tournament *tournament)
+{
+    pthread_t threads[MAX_THREAD];
+    TournamentWorker workers[MAX_THREAD];
+    int i;
+
+    memset(tournament->stats, 0, sizeof(tournament->stats));
+    memset(tournament->seatStats, 0, sizeof(tournament->seatStats));
+    memset(tournament->colourStats, 0, sizeof(tournament->colourStats));
+
+    // Split the games evenly at the start, stealing takes care of the rest
+    for (i = 0; i < tournament->numberOfThreads; i++)
+    {
+        pthread_mutex_init(&tournament->queue[i].lock, NULL);
+        tournament->queue[i].begin = (long)tournament->numberOfGames * i / tournament->numberOfThreads;
+        tournament->queue[i].end = (long)tournament->numberOfGames * (i + 1) / tournament->numberOfThreads;
+    }
+
+    for (i = 0; i < tournament->numberOfThreads; i++)
+    {
+        workers[i].tournament = tournament;
+        workers[i].id = i;
+        pthread_create(&threads[i], NULL, tournamentWorker, &workers[i]);
+    }
+
+    for (i = 0; i < tournament->numberOfThreads; i++)
+    {
+        pthread_join(threads[i], NULL);
+    }
+
+    // Other threads might still be stealing until every thread is joined
+    for (i = 0; i < tournament->numberOfThreads; i++)
+    {
+        pthread_mutex_destroy(&tournament->queue[i].lock);
+    }
+
+    showTournamentResult(tournament);
+}
+
+void showTournamentResult(Tournament *tournament)
+{
+    BotStats total[NUMBER_OF_BOT_TYPES];
+    BotStats seats[4];
+    BotStats colours[4];
+    int i, j;
+
+    memset(total, 0, sizeof(total));
+    memset(seats, 0, sizeof(seats));
+    memset(colours, 0, sizeof(colours));
+
+    // Merge the statistic of every thread
+    for (i = 0; i < tournament->numberOfThreads; i++)
+    {
+        for (j = 0; j < NUMBER_OF_BOT_TYPES; j++)
+        {
+            mergeBotStats(&total[j], &tournament->stats[i][j]);
+        }
+        for (j = 0; j < 4; j++)
+        {
+            mergeBotStats(&seats[j], &tournament->seatStats[i][j]);
+            mergeBotStats(&colours[j], &tournament->colourStats[i][j]);
+        }
+    }
+
+    if (tournament->format == OUTPUT_TABLE)
+    {
+        printTournamentResult(tournament, total);
+    }
+    else
+    {
+        printSimulationResult(tournament, total, seats, colours);
+    }
+}
+
+void printTournamentResult(Tournament *tournament, BotStats total[NUMBER_OF_BOT_TYPES])
+{
+    char botNames[NUMBER_OF_BOT_TYPES][10] = {"Jorgen", "Hans", "Muller", "Klaus", "Franz", "Werner"};
+    int i;
+
+    printf("Tournament of %d games on %d threads, seed %llu\n\n",
+           tournament->numberOfGames, tournament->numberOfThreads, (unsigned long long)tournament->seed);
+    printf("%-8s %9s %7s %9s %9s %9s %9s %10s %8s %8s\n",
+           "Bot", "Games", "Win%", "1st", "2nd", "3rd", "4th", "Unfinished", "Kill/g", "Move/g");
+
+    for (i = 0; i < NUMBER_OF_BOT_TYPES; i++)
+    {
+        // Bots that are not in the lineup are not shown
+        if (total[i].games == 0)
+        {
+            continue;
+        }
+
+        printf("%-8s %9ld %6.2f%% %9ld %9ld %9ld %9ld %10ld %8.2f %8.2f\n",
+               botNames[i], total[i].games, 100.0 * total[i].place[0] / total[i].games,
+               total[i].place[0], total[i].place[1], total[i].place[2], total[i].place[3], total[i].unfinished,
+               (double)total[i].kill / total[i].games, (double)total[i].move / total[i].games);
+    }
+}
+
+void printStatsCsv(FILE *file, char group[], char name[], BotStats *stats)
+{
+    int i;
+
+    if (stats->games == 0)
+    {
+        return;
+    }
+
+    fprintf(file, "%s,%s,%ld,%.4f,%ld,%ld,%ld,%ld,%ld,%.4f,%.4f,%.2f,%.2f,%ld,%ld",
+            group, name, stats->games, (double)stats->place[0] / stats->games,
+            stats->place[0], stats->place[1], stats->place[2], stats->place[3], stats->unfinished,
+            (double)stats->kill / stats->games, (double)stats->move / stats->games,
+            (double)stats->turns / stats->games, (double)stats->score / stats->games,
+            stats->minScore, stats->maxScore);
+
+    for (i = 0; i < SCORE_BUCKETS; i++)
+    {
+        fprintf(file, ",%ld", stats->scores[i]);
+    }
+    fprintf(file, "\n");
+}
+
+void printStatsJson(FILE *file, char name[], BotStats *stats, bool isFirst)
+{
+    int i;
+
+    fprintf(file, "%s\n    {\"name\": \"%s\", \"games\": %ld, \"win_rate\": %.4f, \"places\": [%ld, %ld, %ld, %ld], \"unfinished\": %ld,\n",
+            isFirst ? "" : ",", name, stats->games, (double)stats->place[0] / stats->games,
+            stats->place[0], stats->place[1], stats->place[2], stats->place[3], stats->unfinished);
+    fprintf(file, "     \"kills_per_game\": %.4f, \"moves_per_game\": %.4f, \"turns_per_game\": %.2f,\n",
+            (double)stats->kill / stats->games, (double)stats->move / stats->games, (double)stats->turns / stats->games);
+    fprintf(file, "     \"score\": {\"mean\": %.2f, \"min\": %ld, \"max\": %ld, \"lowest\": %d, \"bucket\": %d, \"counts\": [",
+            (double)stats->score / stats->games, stats->minScore, stats->maxScore, LOWEST_SCORE, SCORE_BUCKET);
+
+    for (i = 0; i < SCORE_BUCKETS; i++)
+    {
+        fprintf(file, "%s%ld", i == 0 ? "" : ", ", stats->scores[i]);
+    }
+    fprintf(file, "]}}");
+}
+
+void printSimulationResult(Tournament *tournament, BotStats total[NUMBER_OF_BOT_TYPES], BotStats seats[4], BotStats colours[4])
+{
+    char botNames[NUMBER_OF_BOT_TYPES][10] = {"Jorgen", "Hans", "Muller", "Klaus", "Franz", "Werner"};
+    char colourNames[4][7] = {"Red", "Green", "Yellow", "Blue"};
+    char seatName[12];
+    FILE *file = tournament->output;
+    bool isFirst;
+    int i;
+
+    if (tournament->format == OUTPUT_CSV)
+    {
+        fprintf(file, "group,name,games,win_rate,first,second,third,fourth,unfinished,kills_per_game,moves_per_game,turns_per_game,mean_score,min_score,max_score");
+        // One column for every bucket of the score distribution, named by its lowest score
+        for (i = 0; i < SCORE_BUCKETS; i++)
+        {
+            fprintf(file, ",score_%d", LOWEST_SCORE + i * SCORE_BUCKET);
+        }
+        fprintf(file, "\n");
+
+        for (i = 0; i < NUMBER_OF_BOT_TYPES; i++)
+        {
+            printStatsCsv(file, "bot", botNames[i], &total[i]);
+        }
+        for (i = 0; i < tournament->numberOfSeats; i++)
+        {
+            snprintf(seatName, sizeof(seatName), "%d", i + 1);
+            printStatsCsv(file, "seat", seatName, &seats[i]);
+        }
+        for (i = 0; i < 4; i++)
+        {
+            printStatsCsv(file, "colour", colourNames[i], &colours[i]);
+        }
+        return;
+    }
+
+    fprintf(file, "{\n  \"games\": %d, \"threads\": %d, \"seed\": %llu,\n  \"lineup\": [",
+            tournament->numberOfGames, tournament->numberOfThreads, (unsigned long long)tournament->seed);
+    for (i = 0; i < tournament->numberOfSeats; i++)
+    {
+        fprintf(file, "%s\"%s\"", i == 0 ? "" : ", ", botNames[tournament->lineup[i]]);
+    }
+    // Every game has exactly one player in the first seat
+    fprintf(file, "],\n  \"turns_per_game\": %.2f,\n  \"bots\": [", (double)seats[0].turns / seats[0].games);
+
+    isFirst = true;
+    for (i = 0; i < NUMBER_OF_BOT_TYPES; i++)
+    {
+        if (total[i].games != 0)
+        {
+            printStatsJson(file, botNames[i], &total[i], isFirst);
+            isFirst = false;
+        }
+    }
+
+    fprintf(file, "\n  ],\n  \"seats\": [");
+    for (i = 0; i < tournament->numberOfSeats; i++)
+    {
+        snprintf(seatName, sizeof(seatName), "%d", i + 1);
+        printStatsJson(file, seatName, &seats[i], i == 0);
+    }
+
+    fprintf(file, "\n  ],\n  \"colours\": [");
+    isFirst = true;
+    for (i = 0; i < 4; i++)
+    {
+        if (colours[i].games != 0)
+        {
+            printStatsJson(file, colourNames[i], &colours[i], isFirst);
+            isFirst = false;
+        }
+    }
+    fprintf(file, "\n  ]\n}\n");
+}
+
+int tournamentCommand(int argc, char *argv[])
+{
+    Tournament *tournament;
+    char defaultLineup[] = "j,h,m";
+
+    if (argc < 1 || atoi(argv[0]) < 1)
+    {
+        printf("Usage : ludo --tournament <number of games> [bots, e.g. j,h,m,m] [seed]\n");
+        return 1;
+    }
+
+    // The tournament is too big to be put on the stack
+    tournament = malloc(sizeof(Tournament));
+
+    if (tournament == NULL)
+    {
+        printf("Not enough memory for the tournament\n");
+        return 1;
+    }
+
+    tournament->numberOfGames = atoi(argv[0]);
+    tournament->format = OUTPUT_TABLE;
+    tournament->output = stdout;
+    tournament->archive = NULL;
+
+    // Klaus, Franz and Werner think as much whatever the speed of the machine, so the same seed gives the same result
+    searchBudget = 0;
+
+    // The games already use every thread, and one thread keeps Werner the same on every run
+    playoutThreads = 1;
+    tournament->numberOfThreads = getNumberOfThreads();
+
+    // Same seed gives the same result, whatever the number of threads
+    tournament->seed = argc > 2 ? strtoull(argv[2], NULL, 10) : (uint64_t)time(NULL);
+
+    if (!parseLineup(argc > 1 ? argv[1] : defaultLineup, tournament->lineup, &tournament->numberOfSeats))
+    {
+        printf("Lineup must be 2 to 4 bots separated by comma, j for Jorgen, h for Hans, m for Muller, k for Klaus, f for Franz, and w for Werner\n");
+        free(tournament);
+        return 1;
+    }
+
+    runTournament(tournament);
+
+    free(tournament);
+    return 0;
+}
+
+int simulateCommand(int argc, char *argv[])
+{
+    Tournament *tournament;
+    char *lineup = "j,h,m";
+    char *outputName = NULL;
+    char *archiveName = NULL;
+    int threads = 0;
+    bool isValid = argc > 0 && atoi(argv[0]) > 0;
+    int i;
+
+    // The tournament is too big to be put on the stack
+    tournament = malloc(sizeof(Tournament));
+
+    if (tournament == NULL)
+    {
+        printf("Not enough memory for the simulation\n");
+        return 1;
+    }
+
+    tournament->numberOfGames = isValid ? atoi(argv[0]) : 0;
+    tournament->seed = (uint64_t)time(NULL);
+    tournament->format = OUTPUT_CSV;
+    tournament->output = stdout;
+    tournament->archive = NULL;
+
+    for (i = 1; i < argc && isValid; i++)
+    {
+        if (i + 1 >= argc)
+        {
+            isValid = false;
+        }
+        else if (strcmp(argv[i], "--players") == 0)
+        {
+            lineup = argv[++i];
+        }
+        else if (strcmp(argv[i], "--seed") == 0)
+        {
+            tournament->seed = strtoull(argv[++i], NULL, 10);
+        }
+        else if (strcmp(argv[i], "--threads") == 0)
+        {
+            threads = atoi(argv[++i]);
+            isValid = threads >= 1 && threads <= MAX_THREAD;
+        }
+        else if (strcmp(argv[i], "--format") == 0)
+        {
+            i++;
+            tournament->format = strcmp(argv[i], "json") == 0 ? OUTPUT_JSON : OUTPUT_CSV;
+            isValid = strcmp(argv[i], "json") == 0 || strcmp(argv[i], "csv") == 0;
+        }
+        else if (strcmp(argv[i], "--output") == 0)
+        {
+            outputName = argv[++i];
+        }
+        else if (strcmp(argv[i], "--archive") == 0)
+        {
+            archiveName = argv[++i];
+        }
+        else
+        {
+            isValid = false;
+        }
+    }
+
+    if (!isValid)
+    {
+        printf("Usage : ludo --simulate <number of games> [--players j,h,m,m] [--seed <seed>] [--threads <threads>]\n");
+        printf("                                          [--format csv|json] [--output <file>] [--archive <file>]\n");
+        free(tournament);
+        return 1;
+    }
+
+    if (!parseLineup(lineup, tournament->lineup, &tournament->numberOfSeats))
+    {
+        printf("Lineup must be 2 to 4 bots separated by comma, j for Jorgen, h for Hans, m for Muller, k for Klaus, f for Franz, and w for Werner\n");
+        free(tournament);
+        return 1;
+    }
+
+    if (outputName != NULL)
+    {
+        tournament->output = fopen(outputName, "w");
+
+        if (tournament->output == NULL)
+        {
+            printf("Can't write to %s\n", outputName);
+            free(tournament);
+            return 1;
+        }
+    }
+
+    // Same as a tournament, the result only depends on the seed
+    searchBudget = 0;
+    playoutThreads = 1;
+    tournament->numberOfThreads = threads != 0 ? threads : getNumberOfThreads();
+
+    if (archiveName != NULL)
+    {
+        tournament->archive = openArchiveWriter(archiveName, tournament);
+
+        if (tournament->archive == NULL)
+        {
+            printf("Can't write to %s\n", archiveName);
+            if (tournament->output != stdout)
+            {
+                fclose(tournament->output);
+            }
+            free(tournament);
+            return 1;
+        }
+    }
+
+    runTournament(tournament);
+
+    if (tournament->output != stdout)
+    {
+        fclose(tournament->output);
+    }
+
+    if (tournament->archive != NULL && !closeArchiveWriter(tournament->archive))
+    {
+        printf("Can't write to %s\n", archiveName);
+        free(tournament);
+        return 1;
+    }
+
+    free(tournament);
+    return 0;
+}
+
+void getPossibleMove(char posmov[], Tokens temp[], int diceNum)
+{
+    // Clear out the option box before
+    clearOptionBox();
+    // Labeling
+    printToOptionBox("Tokens that can be move : ", 1, 1);
+    int j = 0;
+    for (int i = 0; i < 4; i++)
+    {
+        // Check for possible move
+        posmov[i] = possibleMove(diceNum, temp[i].pos, temp[i].safe);
+        if (posmov[i] == 's')
+        {
+            // If tokens are stuck continue
+            j++;
+            continue;
+        }
+        else
+        {
+            // Show tokens that can be shown
+            wprintw(options, "%c ", tokenShown(i));
+            wrefresh(options);
+            /*
+                Call the input here
+            */
+        }
+        if (j == 4)
+        {
+            // If there's no token that can be moved
+            printToOptionBox("There's no tokens that can be move", strlen("Tokens that can be move : ") + 1, 1);
+            //end the turn
+        }
+    }
+}
+
+int getNumOfToken(char posmov[])
+{
+    int numOfToken;
+    char token;
 
-    // Curses mode intialization
-    initscr();
+    // Label the input
+    printToOptionBox("Choose the token : ", 2, 1);
+    // In case the cursor was set not to be shown
+    curs_set(1);
+    // Also show the echo of the user input
+    echo();
+    // Move the cursor
+    wmove(options, 2, strlen("Choose the token : "));
+    // Get the input
+    wscanw(options, "%c", &token);
+    numOfToken = tokenCharToInt(token);
 
-    // Check for console capabilities
-    if (!has_colors())
+    // Check the validity
+    while (!validateInputToken(numOfToken) || ((posmov[numOfToken] == 's')))
     {
-        printw("No color support on console");
-        getch();
-        exit(1);
+        wmove(options, 2, 0);
+        // Clear the line to show not valid
+        clrtoeol();
+        // Show non validity
+        printToOptionBox("The input isn't valid, please reenter the tokens!!", 2, 1);
+        // Get input
+        printToOptionBox("Choose the token : ", 3, 1);
+        wmove(options, 3, strlen("Choose the token : "));
+        wscanw(options, "%c", &token);
+        numOfToken = tokenCharToInt(token);
+    }
+
+    return numOfToken;
+}
+
+char possibleMove(int diceNum, int x, bool safe)
+{
+    //There's only three possibilities for token, m for move, o for out from base, s for stuck
+    if ((diceNum == 6 && x == 0) && !safe)
+    {
+        return 'o'; //if the token is in the home and can move to board
+    }
+    else if ((diceNum != 6 && x == 0) && !safe)
+    {
+        return 's'; //if the token is in the home and can't move to board
+    }
+    else if ((x != 0) && !safe)
+    {
+        return 'm'; //if the token is in the board
+    }
+    else if ((diceNum > (6 - x)) && safe)
+    {
+        return 's'; //if the token is in the safe zone and the dice number is bigger than required step to finish
+    }
+    else
+    {
+        return 'm'; //if the token is in the safe zone and the dice number isn't bigger than required step to finish
+    }
+    return '0';
+}
+
+bool validateInputToken(int x)
+{
+    if (x >= 0 && x < 4)
+    {
+        return true;
+    }
+    else
+        return false;
+}
+
+void moveForward(GameContext *game, int diceNum, int numOfToken)
+{
+    int colour = game->playerIndex[game->whosTurn - 1];
+    Tokens *token = &game->tokens[colour][numOfToken];
+
+    liftToken(game, colour, numOfToken);
+    hashToken(game, colour, numOfToken);
+
+    // Board position wraps around from 52 to 1
+    token->pos = (token->pos + diceNum - 1) % 52 + 1;
+    token->relpos += diceNum;
+
+    hashToken(game, colour, numOfToken);
+    placeToken(game, colour, numOfToken);
+}
+
+void toHomeBase(GameContext *game, int numOfToken, int index)
+{
+    liftToken(game, index - 1, numOfToken);
+    hashToken(game, index - 1, numOfToken);
+
+    game->tokens[index - 1][numOfToken].pos = 0;
+    game->tokens[index - 1][numOfToken].relpos = 0;
+
+    hashToken(game, index - 1, numOfToken);
+}
+
+void outFromHomeBase(GameContext *game, int numOfToken)
+{
+    int colour = game->playerIndex[game->whosTurn - 1];
+
+    liftToken(game, colour, numOfToken);
+    hashToken(game, colour, numOfToken);
+
+    game->tokens[colour][numOfToken].pos = colourGeometry[colour].start;
+    game->tokens[colour][numOfToken].relpos = 1;
+
+    hashToken(game, colour, numOfToken);
+    placeToken(game, colour, numOfToken);
+}
+
+void moveToSafeZone(GameContext *game, int numOfToken, int diceNum)
+{
+    int colour = game->playerIndex[game->whosTurn - 1];
+    Tokens *token = &game->tokens[colour][numOfToken];
+
+    liftToken(game, colour, numOfToken);
+    hashToken(game, colour, numOfToken);
+
+    token->pos = (token->pos + diceNum) - colourGeometry[colour].safezoneEntry;
+    token->relpos = token->pos;
+    token->safe = true;
+
+    hashToken(game, colour, numOfToken);
+    placeToken(game, colour, numOfToken);
+}
+
+void showOptionBox()
+{
+    // Initialized the box under the board
+    options = newWindow(7, 58, 1, 31);
+
+    // Create the border of the box
+    wborder(options, 0, 0, 0, 0, 0, 0, 0, 0);
+    wrefresh(options);
+}
+
+void destroyOptionBox()
+{
+    // Clean up the border of the option box
+    wborder(options, ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ');
+
+    // Remove the content
+    werase(options);
+
+    // Refresh it
+    wrefresh(options);
+
+    // Remove it
+    delwin(options);
+}
+
+void clearOptionBox()
+{
+    // Clear out the box
+    werase(options);
+
+    // Redraw the box as erasing it also remove the border
+    wborder(options, 0, 0, 0, 0, 0, 0, 0, 0);
+
+    // Refresh the box
+    wrefresh(options);
+}
+
+int suitCheck(int player1, int player2)
+{
+    // If they choose the same option then it's a draw
+    if (player1 == player2)
+    {
+        return 0;
+    }
+    // Kertas vs Gunting, gunting won
+    else if (player1 == 1 && player2 == 2)
+        return 2;
+    // Kertas vs Batu, batu won
+    else if (player1 == 1 && player2 == 3)
+        return 1;
+    // Gunting vs Kertas, gunting won
+    else if (player1 == 2 && player2 == 1)
+        return 1;
+    // Gunting vs Batu, batu won
+    else if (player1 == 2 && player2 == 3)
+        return 2;
+    // Batu vs Kertas, kertas won
+    else if (player1 == 3 && player2 == 1)
+        return 1;
+    // Batu vs Gunting, batu won
+    else if (player1 == 3 && player2 == 2)
+        return 1;
+}
+
+void suitMenu(int *choice)
+{
+    // Make sure the option box is clear of content
+    clearOptionBox();
+
+    // Positioning and looping
+    int i, highlight = 0, position;
+
+    // Options for the user
+    char option[3][10] = {"Kertas", "Gunting", "Batu"};
+    char item[9];
+    char ch;
+
+    // Enable keypad mode for key up and down
+    keypad(options, true);
+
+    // Make sure what has been entered is not shown
+    noecho();
+
+    // Hide the cursor
+    curs_set(0);
+
+    // Show label to informed the user
+    mvwprintw(options, 1, 1, "Pilih opsi untuk suit");
+    position = strlen("Pilih opsi untuk suit");
+
+    // Loop until has been inputed
+    while (1)
+    {
+        // Show the options
+        for (i = 0; i < 4; i++)
+        {
+            // Show the highlighted options with highlights
+            if (i == highlight)
+                wattron(options, A_REVERSE);
+
+            mvwprintw(options, i + 1, position + 1, option[i]);
+
+            if (i == highlight)
+                wattroff(options, A_REVERSE);
+        }
+
+        // Get user input
+        ch = wgetch(options);
+
+        if (ch == (char)KEY_UP)
+        {
+            highlight--;
+            highlight = (highlight < 0) ? 2 : highlight;
+        }
+        else if (ch == (char)KEY_DOWN)
+        {
+            highlight++;
+            highlight = (highlight > 2) ? 0 : highlight;
+        }
+        else if (ch == 10) // Somehow the usage of KEY_ENTER doesn't work, so char 10 is used instead
+        {
+            *choice = highlight + 1;
+            break;
+        }
+    }
+}
+
+int suitRandom(Random *rng)
+{
+    return randomRange(rng, 3) + 1;
+}
+
+void printToOptionBox(char input[], int x, int y)
+{
+    // Print it
+    mvwprintw(options, x, y, input);
+
+    // Refresh the box
+    wrefresh(options);
+}
+
+void positionToCoordinate(Tokens token, int *x, int *y)
+{
+    const BoardCell *cell = &tokenCell[whosOpponents(token.col)][token.safe][token.pos];
+
+    *x = cell->x;
+    *y = cell->y;
+}
+
+void drawTokens(GameContext *game, CellFrame frame[15][15])
+{
+    int tempHome;  // Counting how many tokens are in the homebase of the colour
+    int colour, i; // Looping
+    int x, y;      // Temporary storage for the coordinate in the board
+    int length;    // Number of tokens already shown in the cell
+
+    for (colour = 0; colour < 4; colour++)
+    {
+        tempHome = 0;
+
+        for (i = 0; i < 4; i++)
+        {
+            // Tokens that are still in homebase
+            if (game->tokens[colour][i].pos == 0)
+            {
+                x = homeCell[colour][tempHome].x;
+                y = homeCell[colour][tempHome].y;
+
+                frame[x][y].shown[0] = tokenShown(i);
+                frame[x][y].shown[1] = '\0';
+
+                tempHome++;
+            }
+            else
+            {
+                // Get coordinates
+                positionToCoordinate(game->tokens[colour][i], &x, &y);
+
+                // Tokens on the same cell are shown next to each other
+                length = strlen(frame[x][y].shown);
+                if (length < 8)
+                {
+                    frame[x][y].shown[length] = tokenShown(i);
+                    frame[x][y].shown[length + 1] = '\0';
+                }
+
+                // Show the colour of the token
+                frame[x][y].pair = colourGeometry[colour].pair;
+            }
+        }
     }
+}
 
-    // Starts out colour mode of curses
-    start_color();
+char tokenShown(int index)
+{
+    switch (index)
+    {
+    case 0:
+        return 'A';
+        break;
 
-    // Initalize all the color pairs for the board
-    init_pair(BOARD_BLUE, COLOR_WHITE, COLOR_BLUE);
-    init_pair(BOARD_RED, COLOR_WHITE, COLOR_RED);
-    init_pair(BOARD_GREEN, COLOR_WHITE, COLOR_GREEN);
-    init_pair(BOARD_YELLOW, COLOR_WHITE, COLOR_YELLOW);
-    init_pair(BOARD_WHITE, COLOR_BLACK, COLOR_WHITE);
-    init_pair(BOARD_BLACK, COLOR_WHITE, COLOR_BLACK);
+    case 1:
+        return 'B';
+        break;
 
-    // Set background to black
-    bkgd(COLOR_PAIR(BOARD_BLACK));
-    refresh();
+    case 2:
+        return 'C';
+        break;
 
-    // Check for the highscore file
-    if (!isFileExist("highscore.txt"))
-    {
-        // If none found, initalize the file
-        initHighScore();
+    case 3:
+        return 'D';
+        break;
+
+    default:
+        return 'n';
+        break;
     }
+}
 
-    // Show main menu and get the user choice in menu
-    switch (getUserChoiceinMenu())
+int whosOpponents(char color)
+{
+    switch (color)
     {
-    case 0:
-        /*
-            Play new game here
-            While not gameover, showboard and option box, check who's turn, play
-        */
-        // Get user choice on how many and what kind of bots
-        showNewGameMenu(choice);
-        initPlayerData(choice);
+    case 'r':
+        return 0;
+        break;
 
-        clear();
-        // Pause handler using interupt signal from the user
-        signal(SIGINT, pauseHandler);
+    case 'g':
+        return 1;
+        break;
 
-        // Initialized the board and the option box
-        showOptionBox();
-        initBoard();
+    case 'y':
+        return 2;
+        break;
 
-        // Show the labels
-        showLabel();
+    case 'b':
+        return 3;
+        break;
 
-        // Draw the board
-        showBoard();
+    default:
+        break;
+    }
+}
 
-        // Draw the tokens
-        printTokens();
+int tokenCharToInt(char token)
+{
+    switch (tolower(token))
+    {
+    case 'a':
+        return 0;
+        break;
 
-        while (1)
-        {
-            // Start the turn
-            aTurn();
-            // Move to the next
-            moveToNextTurn();
-            // Check if gameover
-            if (isGameOver())
-            {
-                break;
-            }
-        }
+    case 'b':
+        return 1;
+        break;
 
-        // Delete the board and option box as it's not used anymore
-        destroyBoard();
-        destroyOptionBox();
+    case 'c':
+        return 2;
+        break;
 
-        // Remove the handler as it's not used anymore
-        signal(SIGINT, SIG_DFL);
+    case 'd':
+        return 3;
+        break;
 
-        // Clear out the screen
-        clear();
-        refresh();
+    default:
+        return -1;
+        break;
+    }
+}
 
-        if (isAllBotWin())
+bool isAllBotWin(GameContext *game)
+{
+    int howManyBotsAreWin;
+    for (int i = 0; i < game->numberOfBots + 1; i++)
+    {
+        if (game->players[game->playerIndex[i]].comp)
         {
-            /*
-                Show losing screen here
-            */
-            showLose();
-            getch();
+            if (isItWin(game, game->playerIndex[i]))
+            {
+                howManyBotsAreWin++;
+            }
         }
-        else
-        {
-            /*
-                Show winning screen
-            */
-            showWin();
-
-            // Calculate the high score if player win
-            int score = calculateScore(position);
+    }
+    if (howManyBotsAreWin == game->numberOfBots)
+    {
+        return true;
+    }
+    else
+        return false;
+}
 
-            // If the score is top 10 of the highscore
-            if (isHighScore(score))
+bool isUserWin(GameContext *game)
+{
+    for (int i = 0; i < game->numberOfBots + 1; i++)
+    {
+        if (!game->players[game->playerIndex[i]].comp)
+        {
+            if (isItWin(game, game->playerIndex[i]))
             {
-                newHighScoreMenu(score);
+                return true;
             }
             else
-            {
-                mvprintw(8, getMiddleX(stdscr, strlen("Your score is     ")), "Your score is %d", score);
-                mvprintw(9, getMiddleX(stdscr, strlen("Not a new highscore, press anything to exit...")), "Not a new highscore, press anything to exit...");
-                refresh();
-            }
+                return false;
         }
+    }
+}
 
-        getch();
-        break;
+bool isGameOver(GameContext *game)
+{
+    return (isAllBotWin(game) || isUserWin(game));
+}
 
-    case 1:
-        /*
-            Play resumed game here
-            Check if file exist, check if file empty, load save game into variable, play as usual
-        */
-        clear();
-        if (!isFileExist("currentState.savegame"))
+bool isItWin(GameContext *game, int index)
+{
+    Tokens token[4];
+    int finishedToken = 0;
+    tokensOfPlayer(game, token, index);
+    for (int i = 0; i < 4; i++)
+    {
+        if ((token[i].pos == 6) && token[i].safe) //the safezone number 6 is finish line
         {
-            printw("File don't exist, press anything to exit...");
-            getch();
-            exit(6);
+            finishedToken++;
         }
+    }
+    if (finishedToken == 4)
+    {
+        return true;
+    }
+    else
+        return false;
+}
 
-        // Load game save
-        getGameState();
+void tokensOfPlayer(GameContext *game, Tokens token[], int index)
+{
+    //because of function can return array then instead of function, initialize the token can use procedure to initialize the players token to be checked
+    for (int i = 0; i < 4; i++)
+    {
+        token[i] = game->tokens[index][i];
+    }
+}
 
-        // Pause handler using interupt signal from the user
-        signal(SIGINT, pauseHandler);
+void initHighScore()
+{
+    FILE *yey = fopen("highscore.txt", "wb");
+    Score scr;
 
-        // Initialized the board and the option box
-        showOptionBox();
-        initBoard();
+    strncpy(scr.name, "Belum_ada", 25);
+    scr.score = 0;
+
+    for (int i = 0; i < 10; i++)
+    {
+        fprintf(yey, "%s %d\n", scr.name, scr.score);
+    }
+}
 
-        // Show the labels
-        showLabel();
+void showHighScore()
+{
+    WINDOW *highScore;
+    FILE *yey = fopen("highscore.txt", "rb");
+    Score scr;
+    char temp[55];
+    
+    clear();
+    refresh();
 
-        // Draw the board
-        showBoard();
+    highScore = newWindow(15, 57, getMiddleX(stdscr, 57), 5);
+    wrefresh(highScore);
 
-        // Draw the tokens
-        printTokens();
+    mvwprintw(highScore, 1, getMiddleX(highScore, strlen("WALL OF FAME")), "WALL OF FAME");
+    mvwprintw(highScore, 2, getMiddleX(highScore, strlen("HIGH SCORE OF DECADE")), "HIGH SCORE OF DECADE");
+    wrefresh(highScore);
 
-        while (!isGameOver())
-        {
-            // Start the turn
-            aTurn();
-            // Move to the next
-            moveToNextTurn();
-        }
+    for (int i = 0; i < 10; i++)
+    {
+        fscanf(yey, "%s %d\n", scr.name, &scr.score);
+        mvwprintw(highScore, 3 + i, 3, "%d %s %d\n", (i + 1), scr.name, scr.score);
+    }
+
+    fclose(yey);
+
+    wborder(highScore, 0, 0, 0, 0, 0, 0, 0, 0);
+
+    wattron(highScore, A_REVERSE);
+    mvwprintw(highScore, 14, getMiddleX(highScore, strlen("Exit")), "Exit");
+    wattroff(highScore, A_REVERSE);
+
+    wrefresh(highScore);
+    getch();
+}
+
+void writeHighScore(int newHighScore, char usrname[])
+{
+    FILE *X;
+
+    X = fopen("highscore.txt", "ab");
+    fprintf(X, "%s %d", usrname, newHighScore);
+    fclose(X);
+
+    sortHighScore();
+}
+
+bool isHighScore(int caHighScore)
+{
+    FILE *X;
+    Score scr;
 
-        // Remove the handler
-        signal(SIGINT, SIG_DFL);
+    X = fopen("highscore.txt", "rb");
 
-        // Clear out the screen
-        clear();
-        refresh();
+    for (int i = 0; i < 10; i++)
+    {
+        fscanf(X, "%s %d\n", scr.name, &scr.score);
 
-        if (isAllBotWin())
+        if (scr.score < caHighScore)
         {
-            /*
-                Show losing screen here
-            */
-            showLose();
+            fclose(X);
+            return true;
         }
-        else
-        {
-            /*
-                Show winning screen
-            */
-            showWin();
+    }
+    fclose(X);
+    return false;
+}
 
-            // Calculate the high score if player win
-            int score = calculateScore(position);
+void sortHighScore()
+{
+    FILE *arrange;
+    Score scr[12], temp;
+    int N;
+    int i, j;
 
-            // If the score is top 10 of the highscore
-            if (isHighScore(score))
-            {
-                newHighScoreMenu(score);
-            }
-            else
+    arrange = fopen("highscore.txt", "rb");
+    N = 0;
+    while (!feof(arrange))
+    {
+        fscanf(arrange, "%s %d", scr[N].name, &scr[N].score);
+        N++;
+    }
+
+    fclose(arrange);
+
+    for (i = 0; i < N - 1; i++)
+    {
+        for (j = 0; j < N - i - 1; j++)
+        {
+            if (scr[j].score < scr[j + 1].score)
             {
-                mvprintw(8, getMiddleX(stdscr, strlen("Your score is     ")), "Your score is %d", score);
-                mvprintw(9, getMiddleX(stdscr, strlen("Not a new highscore, press anything to exit...")), "Not a new highscore, press anything to exit...");
-                refresh();
+                temp = scr[j];
+                scr[j] = scr[j + 1];
+                scr[j + 1] = temp;
             }
         }
+    }
 
-        getch();
-        break;
-
-    case 2:
-        /*
-            Show highscore here
-        */
-        clear();
-
-        showHighScore();
-        break;
+    arrange = fopen("highscore.txt", "wb");
 
-    case 3:
-        /*
-            Exit the game here
-            Just do nothing as the endwin and return 0 is right down of this selection
-        */
-        break;
+    for (i = 0; i < 10; i++)
+    {
+        fprintf(arrange, "%s %d\n", scr[i].name, scr[i].score);
     }
 
-    // Curses mode end
-    endwin();
-    return 0;
+    fclose(arrange);
 }
 
-/* Function Body */
-
-WINDOW *newWindow(int line, int collumns, int starty, int startx)
+void aTurn(GameContext *game)
 {
-    WINDOW *win;
+    char posmov[4];      // Storage for possible move
+    int diceRoll = 0;    // Temporary storage for diceroll
+    int numberOfSix = 0; // Count the number of the six in the dice roll
+    int numOfToken;      // Number of token that's going to be moved
+    int i;               // Looping
+    int tempcount = 0;   // Counting the possibilities of stuck
+    Tokens temp[4];      // Temporary token storage for the current player
 
-    win = newwin(line, collumns, startx, starty);
-    // wborder(win, 0, 0, 0, 0, 0, 0, 0, 0);
+    if (isFastForward && game->players[game->playerIndex[game->whosTurn - 1]].comp)
+    {
+        // There's at most 3 bots between two turns of the human, the game is over once the human finished
+        fastForwardTurn(game, turnSummary[numberOfSummary]);
+        numberOfSummary++;
+        return;
+    }
 
-    wrefresh(win);
-    return win;
-}
+    // Control is back to the human after fast forwarded bot turns
+    if (numberOfSummary > 0)
+    {
+        showTurnSummary(game);
+    }
 
-void showBoard()
-{
-    int i; // Rows of Board
-    int j; // Collumn of Board
+    clearOptionBox();
+    switch (game->playerIndex[game->whosTurn - 1] + 1)
+    {
+    case 1:
+        printToOptionBox("Red Turn", 1, 1);
+        break;
 
-    // Blue Corner
-    for (i = 0; i <= 5; i++)
+    case 2:
+        printToOptionBox("Green Turn", 1, 1);
+        break;
+
+    case 3:
+        printToOptionBox("Yellow Turn", 1, 1);
+        break;
+
+    case 4:
+        printToOptionBox("Blue Turn", 1, 1);
+        break;
+    }
+    waitForEvent(PACE_TURN);
+
+    // Get the tokens
+    for (int i = 0; i < 4; i++)
     {
-        for (j = 0; j <= 5; j++)
-        {
-            if (i == 0 && j == 2)
-            {
-                continue;
-            }
-            else if (i == 0 || i == 5)
-            {
-                wbkgd(board[i][j], COLOR_PAIR(BOARD_BLACK));
-                wrefresh(board[i][j]);
-            }
-            else if (j == 0 || j == 5)
-            {
-                wbkgd(board[i][j], COLOR_PAIR(BOARD_BLACK));
-                wrefresh(board[i][j]);
-            }
-            else
-            {
-                wbkgd(board[i][j], COLOR_PAIR(BOARD_BLUE));
-                wrefresh(board[i][j]);
-            }
-        }
+        temp[i] = getTokens(game, i);
     }
 
-    // Red Corner
-    for (i = 0; i <= 5; i++)
+    if (game->players[game->playerIndex[game->whosTurn - 1]].comp)
     {
-        for (j = 9; j <= 14; j++)
+        diceRoll = RollADice(&game->rng);
+        recordEvent(REPLAY_DICE, diceRoll);
+        printw("%d", diceRoll);
+        refresh();
+
+        while (numberOfSix < 3)
         {
-            if (i == 0 && j == 11)
-            {
-                continue;
-            }
-            else if (i == 0 || i == 5)
-            {
-                wbkgd(board[i][j], COLOR_PAIR(BOARD_BLACK));
-                wrefresh(board[i][j]);
-            }
-            else if (j == 9 || j == 14)
-            {
-                wbkgd(board[i][j], COLOR_PAIR(BOARD_BLACK));
-                wrefresh(board[i][j]);
-            }
-            else
+            tempcount = 0;
+
+            // Get the tokens
+            for (int i = 0; i < 4; i++)
             {
-                wbkgd(board[i][j], COLOR_PAIR(BOARD_RED));
-                wrefresh(board[i][j]);
+                temp[i] = getTokens(game, i);
             }
-        }
-    }
 
-    // Green Corner
-    for (i = 9; i <= 14; i++)
-    {
-        for (j = 9; j <= 14; j++)
-        {
-            if (i == 9 && j == 11)
+            for (int i = 0; i < 4; i++)
             {
-                continue;
+                posmov[i] = possibleMove(diceRoll, temp[i].pos, temp[i].safe);
             }
-            else if (i == 9 || i == 14)
+
+            for (i = 0; i < 4; i++)
             {
-                wbkgd(board[i][j], COLOR_PAIR(BOARD_BLACK));
-                wrefresh(board[i][j]);
+                if (posmov[i] == 's')
+                    tempcount++;
             }
-            else if (j == 9 || j == 14)
+
+            if (tempcount < 4)
             {
-                wbkgd(board[i][j], COLOR_PAIR(BOARD_BLACK));
-                wrefresh(board[i][j]);
+                numOfToken = botChooseToken(game, posmov, temp, diceRoll, numberOfSix);
+                recordEvent(REPLAY_TOKEN, numOfToken);
+
+                moveToken(game, diceRoll, temp[numOfToken], posmov[numOfToken], numOfToken);
+
+                // Redraw the cells that are changed by the move
+                renderBoard(game);
+
+                if (diceRoll == 6 && numberOfSix < 3)
+                {
+                    numberOfSix++;
+                    diceRoll = RollADice(&game->rng);
+                    // The roll after the third six is not played
+                    if (numberOfSix < 3)
+                    {
+                        recordEvent(REPLAY_DICE, diceRoll);
+                    }
+                    printw("%d", diceRoll);
+                    refresh();
+                }
+                else
+                {
+                    break;
+                }
             }
             else
             {
-                wbkgd(board[i][j], COLOR_PAIR(BOARD_GREEN));
-                wrefresh(board[i][j]);
+                break;
             }
         }
     }
-
-    // Yellow Corner
-    for (i = 9; i <= 14; i++)
+    else
     {
-        for (j = 0; j <= 5; j++)
+        // Human player
+        diceRoll = getDiceRoll(&game->rng);
+        recordEvent(REPLAY_DICE, diceRoll);
+
+        while (numberOfSix < 3)
         {
-            if (i == 9 && j == 2)
-            {
-                continue;
-            }
-            else if (i == 9 || i == 14)
-            {
-                wbkgd(board[i][j], COLOR_PAIR(BOARD_BLACK));
-                wrefresh(board[i][j]);
-            }
-            else if (j == 0 || j == 5)
-            {
-                wbkgd(board[i][j], COLOR_PAIR(BOARD_BLACK));
-                wrefresh(board[i][j]);
-            }
-            else
+            tempcount = 0;
+
+            // Get the tokens
+            for (int i = 0; i < 4; i++)
             {
-                wbkgd(board[i][j], COLOR_PAIR(BOARD_YELLOW));
-                wrefresh(board[i][j]);
+                temp[i] = getTokens(game, i);
             }
-        }
-    }
 
-    // Line on j = 6
-    for (i = 0; i <= 14; i++)
-    {
-        if (i != 6 && i != 7 && i != 8)
-        {
-            wbkgd(board[i][6], COLOR_PAIR(BOARD_WHITE));
-            wrefresh(board[i][6]);
-        }
-    }
+            getPossibleMove(posmov, temp, diceRoll);
 
-    // Line on j = 8
-    for (i = 0; i <= 14; i++)
-    {
-        if (i != 6 && i != 7 && i != 8)
-        {
-            wbkgd(board[i][8], COLOR_PAIR(BOARD_WHITE));
-            wrefresh(board[i][8]);
-        }
-    }
+            for (i = 0; i < 4; i++)
+            {
+                if (posmov[i] == 's')
+                    tempcount++;
+            }
 
-    // Two of single blocks on j = 7
-    wbkgd(board[0][7], COLOR_PAIR(BOARD_WHITE));
-    wrefresh(board[0][7]);
+            // If there's no tokens that can be moved no need for input
+            if (tempcount < 4)
+            {
+                // Get number of token that want to be move
+                numOfToken = getNumOfToken(posmov);
+                recordEvent(REPLAY_TOKEN, numOfToken);
 
-    wbkgd(board[14][7], COLOR_PAIR(BOARD_WHITE));
-    wrefresh(board[14][7]);
+                // Move the token
+                moveToken(game, diceRoll, temp[numOfToken], posmov[numOfToken], numOfToken);
+            }
+            else
+            {
+                printToOptionBox("No possible move, press any key to continue...", 1, 1);
+                getch();
+            }
 
-    // Line on i = 6
-    for (j = 0; j <= 14; j++)
-    {
-        if (j != 6 && j != 7 && j != 8)
-        {
-            wbkgd(board[6][j], COLOR_PAIR(BOARD_WHITE));
-            wrefresh(board[6][j]);
-        }
-    }
+            // Redraw the cells that are changed by the move
+            renderBoard(game);
 
-    // Line on i = 8
-    for (j = 0; j <= 14; j++)
-    {
-        if (j != 6 && j != 7 && j != 8)
-        {
-            wbkgd(board[8][j], COLOR_PAIR(BOARD_WHITE));
-            wrefresh(board[8][j]);
+            if (diceRoll == 6 && numberOfSix < 3)
+            {
+                numberOfSix++;
+                diceRoll = getDiceRoll(&game->rng);
+                // The roll after the third six is not played
+                if (numberOfSix < 3)
+                {
+                    recordEvent(REPLAY_DICE, diceRoll);
+                }
+            }
+            else
+            {
+                break;
+            }
         }
     }
+}
 
-    // Two of single blocks on i = 7
-    wbkgd(board[7][0], COLOR_PAIR(BOARD_WHITE));
-    wrefresh(board[7][0]);
+void showTurnSummary(GameContext *game)
+{
+    int i;
 
-    wbkgd(board[7][14], COLOR_PAIR(BOARD_WHITE));
-    wrefresh(board[7][14]);
+    // The board is drawn once for every bot turn
+    renderBoard(game);
 
-    // Blue Safezone
-    /* 
-        For some unknown reason using loop doesnt work on this particular horizontal line    
-    */
-    // for (j = 1; j <= 6; j++)
-    // {
-    //     printw("%d", j);
-    //     wbkgd(board[7][i], COLOR_PAIR(1));
-    //     wrefresh(board[7][i]);
-    // }
+    clearOptionBox();
+    for (i = 0; i < numberOfSummary; i++)
+    {
+        printToOptionBox(turnSummary[i], i + 1, 1);
+    }
+    printToOptionBox("Press any key to continue...", 5, 1);
 
-    wbkgd(board[7][1], COLOR_PAIR(BOARD_BLUE));
-    wrefresh(board[7][1]);
+    // Keys pressed before the summary is shown don't skip it
+    flushinp();
+    noecho();
+    wgetch(options);
 
-    wbkgd(board[7][2], COLOR_PAIR(BOARD_BLUE));
-    wrefresh(board[7][2]);
+    numberOfSummary = 0;
+}
 
-    wbkgd(board[7][3], COLOR_PAIR(BOARD_BLUE));
-    wrefresh(board[7][3]);
+int getDiceRoll(Random *rng)
+{
+    int roll;
+    // Get clear the option box
+    clearOptionBox();
 
-    wbkgd(board[7][4], COLOR_PAIR(BOARD_BLUE));
-    wrefresh(board[7][4]);
+    printToOptionBox("Press any key to roll the dice", 1, 1);
+    curs_set(0);
+    wmove(options, 1, 1);
+    clrtoeol();
+    getch();
 
-    wbkgd(board[7][5], COLOR_PAIR(BOARD_BLUE));
-    wrefresh(board[7][5]);
+    roll = RollADice(rng);
+    mvwprintw(options, 1, 1, "You got %d press anything to continue", roll);
+    wrefresh(options);
+    getch();
+    return roll;
+}
 
-    wbkgd(board[7][6], COLOR_PAIR(BOARD_BLUE));
-    wrefresh(board[7][6]);
+void pauseHandler(int signum)
+{
+    WINDOW *pauseScreen; // Pause screen
+    int i, highlight = 0, position;
 
-    // Red Safezone
-    for (i = 1; i <= 6; i++)
-    {
-        wbkgd(board[i][7], COLOR_PAIR(BOARD_RED));
-        wrefresh(board[i][7]);
-    }
+    // Options for the user
+    char options[4][15] = {"Resume", "Save Game", "Save & Exit", "Exit"};
+    char item[9];
+    char ch;
 
-    // Green Safezone
-    /* 
-        For some unknown reason using loop doesnt work on this particular horizontal line    
-    */
-    // for (j = 8; j <= 13; j++)
-    // {
-    //     wbkgd(board[7][i], COLOR_PAIR(3));
-    //     wrefresh(board[7][i]);
-    // }
+    // Create new window for the menu
+    pauseScreen = newWindow(10, 30, getMiddleX(stdscr, 30), 12);
+    box(pauseScreen, 0, 0);
 
-    wbkgd(board[7][8], COLOR_PAIR(BOARD_GREEN));
-    wrefresh(board[7][8]);
+    // Enable keypad mode for key up and down
+    keypad(pauseScreen, true);
 
-    wbkgd(board[7][9], COLOR_PAIR(BOARD_GREEN));
-    wrefresh(board[7][9]);
+    // Make sure what has been entered is not shown
+    noecho();
 
-    wbkgd(board[7][10], COLOR_PAIR(BOARD_GREEN));
-    wrefresh(board[7][10]);
+    // Hide the cursor
+    curs_set(0);
 
-    wbkgd(board[7][11], COLOR_PAIR(BOARD_GREEN));
-    wrefresh(board[7][11]);
+    // Loop until has been inputed
+    while (1)
+    {
+        // Show the options
+        for (i = 0; i < 4; i++)
+        {
+            position = getMiddleX(pauseScreen, strlen(options[i]));
 
-    wbkgd(board[7][12], COLOR_PAIR(BOARD_GREEN));
-    wrefresh(board[7][12]);
+            // Show the highlighted options with highlights
+            if (i == highlight)
+                wattron(pauseScreen, A_REVERSE);
 
-    wbkgd(board[7][13], COLOR_PAIR(BOARD_GREEN));
-    wrefresh(board[7][13]);
+            mvwprintw(pauseScreen, i + 1, position, options[i]);
 
-    // Yellow Safezone
-    for (i = 8; i <= 13; i++)
-    {
-        wbkgd(board[i][7], COLOR_PAIR(BOARD_YELLOW));
-        wrefresh(board[i][7]);
-    }
-}
+            if (i == highlight)
+                wattroff(pauseScreen, A_REVERSE);
+        }
 
-void initBoard()
-{
-    int i;
-    int j;
-    int x = 1, y = 1; // Initial position of board, top left of board
+        // Get user input
+        ch = wgetch(pauseScreen);
 
-    // Create new window for each 14 * 14 board
-    // With the size each of the board, 2 rows and 4 collumns
-    // Starting from (1, 1)
-    for (i = 0; i < 15; i++)
-    {
-        for (j = 0; j < 15; j++)
+        if (ch == (char)KEY_UP)
         {
-            if (i == 0 && j == 1)
-            {
-                board[i][j] = newWindow(2, 8, x, y);
-            }
-            else if (i == 9 && j == 10)
+            highlight--;
+            highlight = (highlight < 0) ? 3 : highlight;
+        }
+        else if (ch == (char)KEY_DOWN)
+        {
+            highlight++;
+            highlight = (highlight > 3) ? 0 : highlight;
+        }
+        else if (ch == 10) // Somehow the usage of KEY_ENTER doesn't work, so char 10 is used instead
+        {
+            if (highlight == 0)
             {
-                board[i][j] = newWindow(2, 8, x, y);
+                break;
             }
-            else if (i == 0 && j == 10)
+            else if (highlight == 1)
             {
-                board[i][j] = newWindow(2, 8, x, y);
+                saveGamestate(&currentGame);
+                break;
             }
-            else if (i == 9 && j == 1)
+            else if (highlight == 2)
             {
-                board[i][j] = newWindow(2, 8, x, y);
+                saveGamestate(&currentGame);
+
+                endwin();
+                exit(5);
             }
             else
             {
-                board[i][j] = newWindow(2, 4, x, y);
+                endwin();
+                exit(5);
             }
-
-            x += 4;
-            refresh();
         }
-        x = 1;
-        y += 2;
     }
 
-    delwin(board[0][2]);
-    delwin(board[0][11]);
-    delwin(board[9][2]);
-    delwin(board[9][11]);
+    // After user input clear out the border and window as
+    // it is not used anymore
+    werase(pauseScreen);
+    wborder(pauseScreen, ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ');
+    wrefresh(pauseScreen);
+    delwin(pauseScreen);
+
+    // The pause screen is drawn over the board
+    invalidateBoard();
 }
 
-void clearBoard()
+int botJorgen(GameContext *game, char posmov[], Tokens temp[])
 {
-    int i;
-    int j;
+    // Same arguments as the other bots, Jorgen only looks at the possible moves
+    (void)game;
 
-    // Get every block of the board and clears it
-    for (i = 0; i < 15; i++)
+    //moving token out of home base
+    for (int i = 0; i < 4; i++)
     {
-        for (j = 0; j < 15; j++)
+        if (posmov[i] == 'o')
         {
-            if (i == 0 && j == 2)
-            {
-                continue;
-            }
-            else if (i == 0 && j == 11)
-            {
-                continue;
-            }
-            else if (i == 9 && j == 2)
-            {
-                continue;
-            }
-            else if (i == 9 && j == 11)
-            {
-                continue;
-            }
-            else
-            {
-                werase(board[i][j]);
-                wrefresh(board[i][j]);
-            }
+            return i;
         }
     }
-}
 
-void destroyBoard()
-{
-    int i; // Rows of Board
-    int j; // Collumns of Board
+    //moving the token in safe zone
 
-    for (i = 0; i <= 14; i++)
+    int inSafeZone = 0, numOfToken = -1;
+
+    for (int i = 0; i < 4; i++)
     {
-        for (j = 0; j <= 14; j++)
+        if (posmov[i] == 'm')
         {
-            if (i == 0 && j == 2)
-            {
-                continue;
-            }
-            else if (i == 0 && j == 11)
-            {
-                continue;
-            }
-            else if (i == 9 && j == 2)
-            {
-                continue;
-            }
-            else if (i == 9 && j == 11)
+            if (temp[i].safe)
             {
-                continue;
+                if (inSafeZone < temp[i].pos)
+                {
+                    inSafeZone = temp[i].pos;
+                    numOfToken = i;
+                }
             }
-            else
-            {
-                // Restore back the window to black
-                wbkgd(board[i][j], COLOR_PAIR(BOARD_BLACK));
+        }
+    }
 
-                // Clear out whatever inside the window
-                werase(board[i][j]);
+    if (numOfToken != -1)
+    {
+        return numOfToken;
+    }
 
-                // Update it
-                wrefresh(board[i][j]);
+    //moving the biggest relpos
+    int relPos = 0;
 
-                // Delete as it's not used anymore
-                delwin(board[i][j]);
+    for (int i = 0; i < 4; i++)
+    {
+        if (posmov[i] == 'm')
+        {
+            if (relPos < temp[i].relpos)
+            {
+                relPos = temp[i].relpos;
+                numOfToken = i;
             }
         }
     }
-}
 
-bool hasColour()
-{
-    return has_colors();
+    return numOfToken;
 }
 
-int getMiddleX(WINDOW *win, int len)
+void saveGamestate(GameContext *game)
 {
-    int x;
-    int y;
-    getmaxyx(win, y, x);
+    /*
+        Save all the game data present at the current call of the function
+        
+        The game state will be saved at currentState.savegame
 
-    return (x / 2) - (len / 2);
-}
+        The file structure will be like this :
+        no  content
+        1   Player data
+        2   Player index
+        3   Red Token
+        4   Green Token
+        5   Yelow Token
+        6   Blue Token
+        7   whosTurn
+        8   count
+        9   numberOfBots
+        10  position
+    */
+    FILE *saveGame; // File for saving gamestate
+    int i;          // Looping
 
-void showLogo()
-{
-    WINDOW *logo;
-    FILE *logo_file;
-    int i;
-    char logo_data[125];
+    // Open the file, rewrites anything in there
+    saveGame = fopen("currentState.savegame", "wb");
 
-    // As logo is an ASCII art it's easier to print from a file
-    // Open it as read-only
-    logo_file = fopen("logo.txt", "r");
+    if (saveGame)
+    {
+        // Save the player data
+        fwrite(game->players, sizeof(Player), 4, saveGame);
+
+        // Save the player index data
+        fwrite(game->playerIndex, sizeof(int), 4, saveGame);
+
+        // Save the red token data
+        fwrite(game->tokens[0], sizeof(Tokens), 4, saveGame);
+
+        // Save the green token data
+        fwrite(game->tokens[1], sizeof(Tokens), 4, saveGame);
+
+        // Save the blue token data
+        fwrite(game->tokens[3], sizeof(Tokens), 4, saveGame);
 
-    // File not found or cannot be openned
-    if (logo_file == NULL)
-    {
-        erase();
+        // Save the yellow token data
+        fwrite(game->tokens[2], sizeof(Tokens), 4, saveGame);
 
-        printw("Logo file not found / permission problems");
-        getch();
+        // Save the current turn
+        fwrite(&game->whosTurn, sizeof(int), 1, saveGame);
 
-        // Return back the console properties
-        echo();
-        curs_set(1);
-        exit(3);
-    }
+        // Save the count as it's crucial part of the playgame
+        fwrite(&game->count, sizeof(int), 1, saveGame);
 
-    // New widow to put the logo
-    // Horizontally center
-    logo = newWindow(10, 41, getMiddleX(stdscr, 35), 1);
+        // Save the numberOfBots
+        fwrite(&game->numberOfBots, sizeof(int), 1, saveGame);
 
-    // Show the logo
-    for (i = 0; i < 9; i++)
+        // Save the position of the player
+        fwrite(&game->position, sizeof(int), 1, saveGame);
+    }
+    else
     {
-        if (fgets(logo_data, 125, logo_file) != NULL)
-        {
-            mvwprintw(logo, i, 0, logo_data);
-        }
-        else
-        {
-            // If somehow the file reaches End-Of-File
-            mvwprintw(logo, i, 0, "EOF!");
-        }
+        clear();
+        printw("Save file cannot be openned, press anything to exit...");
+        getch();
+        exit(6);
     }
 
-    // Close the file and refresh the screen
-    fclose(logo_file);
-    wrefresh(logo);
-
-    // Delete the window as it's not used anymore
-    delwin(logo);
+    // Close
+    fclose(saveGame);
 }
 
-void showMainMenu(int *choice)
+void getGameState(GameContext *game)
 {
-    WINDOW *mainmenu;
-    int i, highlight = 0, position;
+    FILE *saveGame; // File for saving gamestate
+    int i;          // Looping
 
-    // Options for the user
-    char options[4][10] = {"New Game", "Resume", "Highscore", "Exit"};
-    char item[9];
-    char ch;
+    // Open the file, read it as a binary file
+    saveGame = fopen("currentState.savegame", "rb");
 
-    // Show logo before the menu
-    showLogo();
+    if (saveGame)
+    {
+        // Get the player data
+        fread(game->players, sizeof(Player), 4, saveGame);
 
-    // Create new window for the menu
-    mainmenu = newWindow(10, 57, getMiddleX(stdscr, 57), 12);
-    box(mainmenu, 0, 0);
+        // Get the player index data
+        fread(game->playerIndex, sizeof(int), 4, saveGame);
 
-    // Enable keypad mode for key up and down
-    keypad(mainmenu, true);
+        // Get the red token data
+        fread(game->tokens[0], sizeof(Tokens), 4, saveGame);
 
-    // Make sure what has been entered is not shown
-    noecho();
+        // Get the green token data
+        fread(game->tokens[1], sizeof(Tokens), 4, saveGame);
 
-    // Hide the cursor
-    curs_set(0);
+        // Get the blue token data
+        fread(game->tokens[3], sizeof(Tokens), 4, saveGame);
 
-    // Loop until has been inputed
-    while (1)
-    {
-        // Show the options
-        for (i = 0; i < 4; i++)
-        {
-            position = getMiddleX(mainmenu, strlen(options[i]));
+        // Get the yellow token data
+        fread(game->tokens[2], sizeof(Tokens), 4, saveGame);
 
-            // Show the highlighted options with highlights
-            if (i == highlight)
-                wattron(mainmenu, A_REVERSE);
+        // Get the current turn
+        fread(&game->whosTurn, sizeof(int), 1, saveGame);
 
-            mvwprintw(mainmenu, i + 1, position, options[i]);
+        // Get the count as it's crucial part of the playgame
+        fread(&game->count, sizeof(int), 1, saveGame);
 
-            if (i == highlight)
-                wattroff(mainmenu, A_REVERSE);
-        }
+        // Get the numberOfBots
+        fread(&game->numberOfBots, sizeof(int), 1, saveGame);
 
-        // Get user input
-        ch = wgetch(mainmenu);
+        // Get the position of the player
+        fread(&game->position, sizeof(int), 1, saveGame);
 
-        if (ch == (char)KEY_UP)
-        {
-            highlight--;
-            highlight = (highlight < 0) ? 3 : highlight;
-        }
-        else if (ch == (char)KEY_DOWN)
-        {
-            highlight++;
-            highlight = (highlight > 3) ? 0 : highlight;
-        }
-        else if (ch == 10) // Somehow the usage of KEY_ENTER doesn't work, so char 10 is used instead
-        {
-            *choice = highlight;
-            break;
-        }
+        // Occupancy index is not saved, it's rebuilt from the tokens
+        buildOccupancy(game);
+    }
+    else
+    {
+        clear();
+        printw("Save file cannot be openned, press anything to exit...");
+        getch();
+        exit(6);
     }
 
-    // After user input clear out the border and window as
-    // it is not used anymore
-    wborder(mainmenu, ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ');
-    delwin(mainmenu);
+    // Close
+    fclose(saveGame);
 }
 
-int getUserChoiceinMenu()
+void startRecording(GameContext *game)
 {
-    int choice;
+    ReplayHeader header;
 
-    // Show the user the menu and get the choice from it
-    showMainMenu(&choice);
+    if (recordName == NULL)
+    {
+        return;
+    }
 
-    // Clean out the window
-    erase();
+    recordFile = fopen(recordName, "wb");
 
-    // printw("%d", choice);
-    refresh();
+    if (recordFile == NULL)
+    {
+        // The game is still played, only without the log
+        return;
+    }
 
-    return choice;
+    memset(&header, 0, sizeof(header));
+    strcpy(header.magic, REPLAY_MAGIC);
+    header.seed = game->rng.state;
+    memcpy(header.players, game->players, sizeof(header.players));
+    memcpy(header.playerIndex, game->playerIndex, sizeof(header.playerIndex));
+    memcpy(header.tokens, game->tokens, sizeof(header.tokens));
+    header.numberOfBots = game->numberOfBots;
+    header.whosTurn = game->whosTurn;
+    header.count = game->count;
+    header.position = game->position;
+
+    fwrite(&header, sizeof(header), 1, recordFile);
+
+    recordedEvents = 0;
+    recordedTurns = 0;
+    isKeyframeStopped = false;
+    recordTurnKeyframe(game);
 }
 
-void showNewGameMenu(int choice[3])
+void recordEvent(int type, int value)
 {
-    WINDOW *botchoice;
-
-    int i, j, highlight = 0, position;
-
-    // Options for bots that user can choose
-    char bot_options[4][10] = {"Jörgen", "Hans", "Müller"};
-
-    // Temporary storage for input
-    char item[9];
-    char ch;
-
-    // Initialize the variables
-    for (i = 0; i < 4; i++)
+    if (recordFile != NULL)
     {
-        choice[i] = -1;
+        fputc((type << 6) | value, recordFile);
+        recordedEvents++;
     }
-    numberOfBots = 0;
-
-    // Show the logo beforehand
-    showLogo();
-
-    // Create new window
-    botchoice = newWindow(10, 57, getMiddleX(stdscr, 57), 12);
-    box(botchoice, 0, 0);
+}
 
-    // Un-hide the cursor
-    curs_set(1);
+void recordTurn(GameContext *game)
+{
+    if (recordFile == NULL)
+    {
+        return;
+    }
 
-    // Make sure the user can see what they have inputted before entering it
-    echo();
+    recordEvent(REPLAY_TURN, 0);
+    recordedTurns++;
+    recordTurnKeyframe(game);
+}
 
-    wrefresh(botchoice);
+void recordTurnKeyframe(GameContext *game)
+{
+    ReplayKeyframe *grown;
 
-    while (1)
+    if (isKeyframeStopped || recordedTurns % REPLAY_KEYFRAME_INTERVAL != 0)
     {
-        mvwprintw(botchoice, 3, 4, "How many bots do you want to play with (1 - 3):");
-        wmove(botchoice, 3, strlen("How many bots do you want to play with (1 - 3):") + 4);
+        return;
+    }
 
-        // Get the user input
-        wscanw(botchoice, "%d", &numberOfBots);
+    // Twice as big every time it's full
+    if (numberOfRecordedKeyframes == recordedKeyframesSize)
+    {
+        grown = realloc(recordedKeyframes, (recordedKeyframesSize * 2 + 16) * sizeof(ReplayKeyframe));
 
-        // Check for validity of input
-        if (numberOfBots > 0 && numberOfBots < 4)
+        if (grown == NULL)
         {
-            break;
+            // The keyframes so far are still good, the viewer plays on from the last one
+            isKeyframeStopped = true;
+            return;
         }
-
-        wrefresh(botchoice);
+        recordedKeyframes = grown;
+        recordedKeyframesSize = recordedKeyframesSize * 2 + 16;
     }
 
-    // Cleared out the box for next stage of menu
-    werase(botchoice);
-
-    // Re-box the window as erase also remove the box from the window
-    box(botchoice, 0, 0);
-
-    // Enable usage of keypad
-    keypad(botchoice, true);
+    makeKeyframe(game, recordedEvents, &recordedKeyframes[numberOfRecordedKeyframes]);
+    numberOfRecordedKeyframes++;
+}
 
-    // Don't show the user input
-    noecho();
+void makeKeyframe(GameContext *game, long event, ReplayKeyframe *keyframe)
+{
+    int colour, i;
 
-    // Hide the cursor
-    curs_set(0);
+    memset(keyframe, 0, sizeof(ReplayKeyframe));
+    keyframe->count = game->count;
+    keyframe->event = event;
+    keyframe->position = game->position;
 
-    // Loops the input stage as much as the user has inputted
-    for (j = 0; j < numberOfBots; j++)
+    for (colour = 0; colour < 4; colour++)
     {
-        // Reset the highlight index each time
-        highlight = 0;
+        keyframe->kill[colour] = game->players[colour].kill;
+        keyframe->move[colour] = game->players[colour].move;
 
-        while (1)
+        for (i = 0; i < 4; i++)
         {
-            wmove(options, 1, 1);
-            clrtoeol();
-            // Show the current bot number
-            mvwprintw(botchoice, 1, getMiddleX(botchoice, strlen("Bot no. 1")), "Bot no. %d", j + 1);
-
-            // Shows the bot options
-            for (i = 0; i < 3; i++)
-            {
-                // Get the horizontal center for each string
-                position = getMiddleX(botchoice, strlen(bot_options[i]));
+            keyframe->progress[colour][i] = tokenProgress(game->tokens[colour][i]);
+        }
+    }
+}
 
-                // Highlight it for the selected
-                if (i == highlight)
-                    wattron(botchoice, A_REVERSE);
+void restoreKeyframe(Replay *replay, ReplayKeyframe *keyframe, GameContext *game)
+{
+    int colour, i;
 
-                mvwprintw(botchoice, i + 2, position, bot_options[i]);
+    *game = replay->start;
+    game->count = keyframe->count;
+    game->whosTurn = keyframe->count % (game->numberOfBots + 1) + 1;
+    game->position = keyframe->position;
 
-                if (i == highlight)
-                    wattroff(botchoice, A_REVERSE);
-            }
+    for (colour = 0; colour < 4; colour++)
+    {
+        game->players[colour].kill = keyframe->kill[colour];
+        game->players[colour].move = keyframe->move[colour];
 
-            // Get the user actions
-            ch = wgetch(botchoice);
+        // Colours that are not playing keep the tokens of the header
+        if (game->players[colour].col == 'n')
+        {
+            continue;
+        }
 
-            if (ch == (char)KEY_UP)
-            {
-                highlight--;
-                highlight = (highlight < 0) ? 2 : highlight;
-            }
-            else if (ch == (char)KEY_DOWN)
-            {
-                highlight++;
-                highlight = (highlight > 2) ? 0 : highlight;
-            }
-            else if (ch == 10)
-            {
-                choice[j] = highlight;
-                break;
-            }
+        for (i = 0; i < 4; i++)
+        {
+            game->tokens[colour][i] = progressToToken(colour, i, keyframe->progress[colour][i]);
         }
     }
 
-    // Remove borders of the box
-    wborder(botchoice, ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ');
-
-    // Remove the window as it's not used anymore
-    delwin(botchoice);
+    // The hash of the turn is part of the occupancy, so it's rebuilt after the turn is set
+    buildOccupancy(game);
 }
 
-void initHumanPlayerData(int colour)
+void stopRecording()
 {
-    int i;
-    char col; // Colour of the the player
+    ReplayIndex index;
 
-    switch (colour)
+    if (recordFile == NULL)
     {
-    case 0:
-        col = 'r';
-        break;
+        return;
+    }
 
-    case 1:
-        col = 'g';
-        break;
+    // The keyframes and the index are only there if the log is closed here
+    if (numberOfRecordedKeyframes > 0)
+    {
+        memset(&index, 0, sizeof(index));
+        index.numberOfKeyframes = numberOfRecordedKeyframes;
+        index.numberOfTurns = recordedTurns;
+        strcpy(index.magic, REPLAY_INDEX_MAGIC);
 
-    case 2:
-        col = 'y';
-        break;
+        fwrite(recordedKeyframes, sizeof(ReplayKeyframe), numberOfRecordedKeyframes, recordFile);
+        fwrite(&index, sizeof(index), 1, recordFile);
+    }
 
-    case 3:
-        col = 'b';
-        break;
+    fclose(recordFile);
+    recordFile = NULL;
+
+    free(recordedKeyframes);
+    recordedKeyframes = NULL;
+    recordedKeyframesSize = 0;
+    numberOfRecordedKeyframes = 0;
+}
+
+bool loadReplay(char name[], Replay *replay)
+{
+    FILE *file = fopen(name, "rb");
+    ReplayHeader header;
+    ReplayIndex index;
+    GameContext *game = &replay->start;
+    long size;      // Size of the events
+    long indexSize; // Size of the keyframes and their index
+
+    if (file == NULL)
+    {
+        return false;
+    }
 
-    default:
-        break;
+    if (fread(&header, sizeof(header), 1, file) != 1 || strcmp(header.magic, REPLAY_MAGIC) != 0)
+    {
+        fclose(file);
+        return false;
     }
 
-    players[colour].col = col;
-    players[colour].comp = false;
-    players[colour].move = 0;
-    players[colour].kill = 0;
+    fseek(file, 0, SEEK_END);
+    size = ftell(file) - (long)sizeof(header);
+    replay->keyframes = NULL;
+    replay->numberOfKeyframes = 0;
+    replay->numberOfTurns = 0;
 
-    for (i = 0; i < 4; i++)
+    // The index is at the end of the file, the keyframes are just before it
+    if (size >= (long)sizeof(index))
     {
-        switch (col)
-        {
-        case 'r':
-            red[i].col = 'r';
-            red[i].ind = i;
-            red[i].pos = 0;
-            red[i].relpos = 0;
-            red[i].safe = false;
+        fseek(file, -(long)sizeof(index), SEEK_END);
 
-            break;
+        if (fread(&index, sizeof(index), 1, file) == 1 && strcmp(index.magic, REPLAY_INDEX_MAGIC) == 0 && index.numberOfKeyframes > 0)
+        {
+            indexSize = sizeof(index) + index.numberOfKeyframes * (long)sizeof(ReplayKeyframe);
+            replay->keyframes = malloc(index.numberOfKeyframes * sizeof(ReplayKeyframe));
 
-        case 'g':
-            green[i].col = 'g';
-            green[i].ind = i;
-            green[i].pos = 0;
-            green[i].relpos = 0;
-            green[i].safe = false;
+            if (indexSize <= size && replay->keyframes != NULL)
+            {
+                size -= indexSize;
+                fseek(file, sizeof(header) + size, SEEK_SET);
 
-            break;
+                if (fread(replay->keyframes, sizeof(ReplayKeyframe), index.numberOfKeyframes, file) == (size_t)index.numberOfKeyframes)
+                {
+                    replay->numberOfKeyframes = index.numberOfKeyframes;
+                    replay->numberOfTurns = index.numberOfTurns;
+                }
+            }
+        }
+    }
 
-        case 'y':
-            yellow[i].col = 'y';
-            yellow[i].ind = i;
-            yellow[i].pos = 0;
-            yellow[i].relpos = 0;
-            yellow[i].safe = false;
+    // Every byte between the header and the keyframes is one event
+    fseek(file, sizeof(header), SEEK_SET);
+    replay->events = malloc(size > 0 ? size : 1);
+    replay->numberOfEvents = replay->events != NULL ? (long)fread(replay->events, 1, size, file) : 0;
+    fclose(file);
+
+    memset(game, 0, sizeof(GameContext));
+    seedRandom(&game->rng, header.seed);
+    memcpy(game->players, header.players, sizeof(header.players));
+    memcpy(game->playerIndex, header.playerIndex, sizeof(header.playerIndex));
+    memcpy(game->tokens, header.tokens, sizeof(header.tokens));
+    game->numberOfBots = header.numberOfBots;
+    game->whosTurn = header.whosTurn;
+    game->count = header.count;
+    game->position = header.position;
+
+    buildOccupancy(game);
+    return true;
+}
 
-            break;
+bool buildKeyframes(Replay *replay)
+{
+    char summary[SUMMARY_LENGTH];
+    GameContext game = replay->start;
+    long next = 0;
+    int result;
+
+    // Every turn has at least one event, so there's a keyframe for every interval of events at most
+    free(replay->keyframes);
+    replay->keyframes = malloc((replay->numberOfEvents / REPLAY_KEYFRAME_INTERVAL + 1) * sizeof(ReplayKeyframe));
+    replay->numberOfKeyframes = 0;
+    replay->numberOfTurns = 0;
+
+    if (replay->keyframes == NULL)
+    {
+        return false;
+    }
 
-        case 'b':
-            blue[i].col = 'b';
-            blue[i].ind = i;
-            blue[i].pos = 0;
-            blue[i].relpos = 0;
-            blue[i].safe = false;
+    do
+    {
+        if (replay->numberOfTurns % REPLAY_KEYFRAME_INTERVAL == 0)
+        {
+            makeKeyframe(&game, next, &replay->keyframes[replay->numberOfKeyframes]);
+            replay->numberOfKeyframes++;
+        }
 
-            break;
+        result = replayTurn(&game, replay->events, replay->numberOfEvents, &next, summary, false);
 
-        default:
-            break;
+        if (result == 1)
+        {
+            replay->numberOfTurns++;
+            moveToNextTurn(&game);
         }
-    }
+    } while (result == 1);
+
+    return result == 0;
 }
 
-void initBotPlayerData(int botIndexes, int colour)
+bool seekReplay(Replay *replay, int turn, GameContext *game, long *next)
 {
+    char summary[SUMMARY_LENGTH];
+    int index = turn / REPLAY_KEYFRAME_INTERVAL;
     int i;
-    char col;
-    char botIndex;
 
-    switch (colour)
+    // The keyframes of a log can stop early if the recording ran out of memory
+    if (index >= replay->numberOfKeyframes)
     {
-    case 0:
-        col = 'r';
-        break;
+        index = replay->numberOfKeyframes - 1;
+    }
 
-    case 1:
-        col = 'g';
-        break;
+    restoreKeyframe(replay, &replay->keyframes[index], game);
+    *next = replay->keyframes[index].event;
 
-    case 2:
-        col = 'y';
-        break;
+    // The turns after the keyframe are played again from their events
+    for (i = index * REPLAY_KEYFRAME_INTERVAL; i < turn; i++)
+    {
+        if (replayTurn(game, replay->events, replay->numberOfEvents, next, summary, false) != 1)
+        {
+            return false;
+        }
+        moveToNextTurn(game);
+    }
 
-    case 3:
-        col = 'b';
-        break;
+    return true;
+}
 
-    default:
-        break;
+int replayTurn(GameContext *game, uint8_t events[], long numberOfEvents, long *next, char summary[], bool isShown)
+{
+    char colourName[4][7] = {"Red", "Green", "Yellow", "Blue"};
+    char step[SUMMARY_LENGTH]; // Summary of one move
+    Tokens temp;               // The token before it's moved
+    Tokens moved;              // The token after it's moved
+    Tokens opponents[4];       // Opponents on the destination of the moved token
+    char posmov;               // Possible move of the token
+    int diceRoll = 0;          // Last dice roll, 0 if there's none yet
+    int whosWin;               // Result of the suit if there's any
+    int choice, opChoice;      // Suit choices of the player that take turn and of the opponent
+    int type, value;
+
+    if (*next >= numberOfEvents)
+    {
+        return 0;
     }
 
-    switch (botIndexes)
+    sprintf(summary, "%s :", colourName[game->playerIndex[game->whosTurn - 1]]);
+
+    if (isShown)
     {
-    case 0:
-        botIndex = 'j';
-        break;
+        clearOptionBox();
+        printToOptionBox(summary, 1, 1);
+        waitForEvent(PACE_TURN);
+    }
 
-    case 1:
-        botIndex = 'h';
-        break;
+    while (*next < numberOfEvents)
+    {
+        type = events[*next] >> 6;
+        value = events[*next] & 0x3F;
+        (*next)++;
 
-    case 2:
-        botIndex = 'm';
-        break;
+        // A roll that isn't followed by a token means there was no possible move
+        if ((type == REPLAY_TURN || type == REPLAY_DICE) && diceRoll != 0)
+        {
+            sprintf(step, " %d -", diceRoll);
+            strncat(summary, step, SUMMARY_LENGTH - 1 - strlen(summary));
+        }
 
-    default:
-        break;
-    }
+        if (type == REPLAY_TURN)
+        {
+            return 1;
+        }
+        else if (type == REPLAY_DICE)
+        {
+            if (value < 1 || value > 6)
+            {
+                return -1;
+            }
+
+            diceRoll = value;
+            continue;
+        }
+        else if (type == REPLAY_SUIT || diceRoll == 0 || value > 3)
+        {
+            // A suit without a capture or a token without a dice roll
+            return -1;
+        }
 
-    players[colour].col = col;
-    players[colour].comp = true;
-    players[colour].comptype = botIndex;
-    players[colour].move = 0;
-    players[colour].kill = 0;
+        temp = getTokens(game, value);
+        posmov = possibleMove(diceRoll, temp.pos, temp.safe);
 
-    for (i = 0; i < 4; i++)
-    {
-        switch (col)
+        if (posmov == 's')
         {
-        case 'r':
-            red[i].col = 'r';
-            red[i].ind = i;
-            red[i].pos = 0;
-            red[i].relpos = 0;
-            red[i].safe = false;
+            return -1;
+        }
 
-            break;
+        getMoveOpponents(game, diceRoll, temp, posmov, opponents);
+        whosWin = 0;
 
-        case 'g':
-            green[i].col = 'g';
-            green[i].ind = i;
-            green[i].pos = 0;
-            green[i].relpos = 0;
-            green[i].safe = false;
+        // Suits are played again until it's not a draw, as in moveToken
+        while (isCapture(temp, opponents) && whosWin == 0)
+        {
+            if (*next + 1 >= numberOfEvents || events[*next] >> 6 != REPLAY_SUIT || events[*next + 1] >> 6 != REPLAY_SUIT)
+            {
+                return -1;
+            }
 
-            break;
+            choice = events[*next] & 0x3F;
+            opChoice = events[*next + 1] & 0x3F;
+            *next += 2;
 
-        case 'y':
-            yellow[i].col = 'y';
-            yellow[i].ind = i;
-            yellow[i].pos = 0;
-            yellow[i].relpos = 0;
-            yellow[i].safe = false;
+            if (choice < 1 || choice > 3 || opChoice < 1 || opChoice > 3)
+            {
+                return -1;
+            }
+            whosWin = suitCheck(choice, opChoice);
+        }
 
-            break;
+        applyMove(game, diceRoll, temp, posmov, value, opponents, whosWin);
+        moved = getTokens(game, value);
 
-        case 'b':
-            blue[i].col = 'b';
-            blue[i].ind = i;
-            blue[i].pos = 0;
-            blue[i].safe = false;
+        if (moved.pos == 0)
+        {
+            sprintf(step, " %d %c lost to %s", diceRoll, tokenShown(value), colourName[whosOpponents(opponents[0].col)]);
+        }
+        else if (posmov == 'o')
+        {
+            sprintf(step, " %d %c out", diceRoll, tokenShown(value));
+        }
+        else if (moved.safe)
+        {
+            sprintf(step, " %d %c safe %d", diceRoll, tokenShown(value), moved.pos);
+        }
+        else
+        {
+            sprintf(step, " %d %c to %d", diceRoll, tokenShown(value), moved.pos);
+        }
+        strncat(summary, step, SUMMARY_LENGTH - 1 - strlen(summary));
 
-            break;
+        if (isCapture(temp, opponents) && moved.pos != 0)
+        {
+            sprintf(step, " x %s", colourName[whosOpponents(opponents[0].col)]);
+            strncat(summary, step, SUMMARY_LENGTH - 1 - strlen(summary));
+        }
 
-        default:
-            break;
+        if (isShown)
+        {
+            renderBoard(game);
+            printToOptionBox(summary, 1, 1);
+            waitForEvent(isCapture(temp, opponents) ? PACE_RESULT : PACE_MOVE);
         }
+
+        // The token is only chosen once for every roll
+        diceRoll = 0;
     }
+
+    return 1;
 }
 
-void initPlayerData(int botIndexes[3])
+void viewReplay(Replay *replay)
 {
-    int randTemp[4]; // Used for temporary storage of randomized number
-    int i, j;        // Looping variable
-    int temp;
+    char summary[SUMMARY_LENGTH];
+    char line[SUMMARY_LENGTH];
+    GameContext game;
+    long next;
+    int turn = 0; // Turn that's shown, the board is at the end of it
+    int key, target;
+    bool isValid;
 
-    i = 0;
-    srand(time(NULL));
+    keypad(options, true);
 
-    // Make sure non-player are known, intializing null players
-    for (i = 0; i < 4; i++)
+    while (1)
     {
-        players[i].col = 'n';
-    }
+        // The turn is played from the start so its summary can be shown
+        isValid = seekReplay(replay, turn, &game, &next) &&
+                  replayTurn(&game, replay->events, replay->numberOfEvents, &next, summary, false) == 1;
 
-    // Get all uniqe random number
-    i = 0;
-    while (i < 4)
-    {
-        temp = abs(rand() % 4);
+        renderBoard(&game);
+        clearOptionBox();
+        sprintf(line, "Turn %d of %d", turn + 1, replay->numberOfTurns);
+        printToOptionBox(line, 1, 1);
+        printToOptionBox(isValid ? summary : "The replay breaks the rules here", 2, 1);
+        printToOptionBox("Right next, left back, g go to turn, q quit", 4, 1);
 
-        for (j = 0; j < i; j++)
+        noecho();
+        curs_set(0);
+        key = wgetch(options);
+
+        if (key == 'q')
         {
-            if (randTemp[j] == temp)
-            {
-                break;
-            }
+            break;
         }
-
-        if (j == i)
+        else if ((key == KEY_RIGHT || key == 'n') && turn + 1 < replay->numberOfTurns)
         {
-            randTemp[i] = temp;
-            i++;
+            turn++;
         }
-    }
-    initHumanPlayerData(randTemp[0]);
-    playerIndex[0] = randTemp[0];
+        else if ((key == KEY_LEFT || key == 'p') && turn > 0)
+        {
+            turn--;
+        }
+        else if (key == 'g')
+        {
+            printToOptionBox("Go to turn : ", 3, 1);
+            echo();
+            curs_set(1);
+            wmove(options, 3, strlen("Go to turn : ") + 1);
 
-    for (i = 0, j = 1; i < numberOfBots && j < 4; i++, j++)
-    {
-        initBotPlayerData(botIndexes[i], randTemp[j]);
-        playerIndex[j] = randTemp[j];
+            if (wscanw(options, "%d", &target) == 1 && target >= 1 && target <= replay->numberOfTurns)
+            {
+                turn = target - 1;
+            }
+        }
     }
 }
 
-void getOpponents(Tokens token, Tokens opponents[], int index)
+int replayCommand(char name[])
 {
-    int i, j = 0;
-
-    if (index > 52)
+    char colourName[4][7] = {"Red", "Green", "Yellow", "Blue"};
+    char summary[SUMMARY_LENGTH];
+    GameContext game;
+    Replay replay;
+    long next = 0;
+    int result, i;
+
+    if (!loadReplay(name, &replay))
     {
-        index -= 52;
+        printf("%s is not a replay log\n", name);
+        return 1;
     }
+    game = replay.start;
 
-    // Loops every array of token colour
-    for (i = 0; i < 4; i++)
+    if (isViewing)
     {
-        // Oppponents is there only if they're not the same colour, have the same positions
-        // and not in the safezone
-        if (red[i].col != token.col && red[i].pos == index && !red[i].safe)
+        // Logs of games that were left before the end have no keyframes
+        if (replay.numberOfKeyframes == 0 && !buildKeyframes(&replay))
         {
-            opponents[j] = red[i];
-            j++;
+            printf("%s breaks the rules\n", name);
+            free(replay.events);
+            free(replay.keyframes);
+            return 1;
         }
-        else if (green[i].col != token.col && green[i].pos == index && !green[i].safe)
+
+        if (replay.numberOfTurns == 0)
         {
-            opponents[j] = green[i];
-            j++;
+            printf("%s has no turns\n", name);
+            free(replay.events);
+            free(replay.keyframes);
+            return 1;
         }
-        else if (blue[i].col != token.col && blue[i].pos == index && !blue[i].safe)
+
+        initScreen();
+        showOptionBox();
+        initBoard();
+        viewReplay(&replay);
+
+        destroyBoard();
+        destroyOptionBox();
+        endwin();
+
+        free(replay.events);
+        free(replay.keyframes);
+        return 0;
+    }
+
+    if (isWatching)
+    {
+        initScreen();
+        showOptionBox();
+        initBoard();
+        renderBoard(&game);
+    }
+    else
+    {
+        printf("Replay of %s, seed %llu, %ld events\n\n", name, (unsigned long long)game.rng.state, replay.numberOfEvents);
+    }
+
+    while ((result = replayTurn(&game, replay.events, replay.numberOfEvents, &next, summary, isWatching)) == 1)
+    {
+        if (!isWatching)
         {
-            opponents[j] = blue[i];
-            j++;
+            printf("%5d %s\n", game.count + 1, summary);
         }
-        else if (yellow[i].col != token.col && yellow[i].pos == index && !yellow[i].safe)
+        moveToNextTurn(&game);
+    }
+
+    if (isWatching)
+    {
+        clearOptionBox();
+        printToOptionBox(result == 0 ? "End of the replay, press any key to exit..." : "The replay breaks the rules here, press any key to exit...", 1, 1);
+        getch();
+
+        destroyBoard();
+        destroyOptionBox();
+        endwin();
+    }
+
+    free(replay.events);
+    free(replay.keyframes);
+
+    if (result == -1)
+    {
+        printf("Event %ld of %s breaks the rules\n", next - 1, name);
+        return 1;
+    }
+
+    if (!isWatching)
+    {
+        printf("\nFinished :");
+        for (i = 0; i < 4; i++)
         {
-            opponents[j] = yellow[i];
-            j++;
+            if (game.players[i].col != 'n' && isItWin(&game, i))
+            {
+                printf(" %s", colourName[i]);
+            }
         }
+        printf("\n");
     }
 
-    // If none were found return with colour n (null)
-    if (j == 0)
+    return 0;
+}
+
+void writeBits(BitStream *bits, int value, int count)
+{
+    int i;
+
+    for (i = 0; i < count; i++)
     {
-        opponents[0].col = 'n';
+        // A new byte starts empty, so the buffer doesn't have to be cleared for every game
+        if (bits->numberOfBits % 8 == 0)
+        {
+            bits->bytes[bits->numberOfBits / 8] = 0;
+        }
+
+        bits->bytes[bits->numberOfBits / 8] |= ((value >> i) & 1) << (bits->numberOfBits % 8);
+        bits->numberOfBits++;
     }
 }
 
-bool isTransitionToSafezone(Tokens token, int diceroll)
+int readBits(uint8_t bytes[], long size, long *next, int count)
 {
-    return (token.relpos + diceroll) > 51;
+    int value = 0;
+    int i;
+
+    if (*next + count > size * 8)
+    {
+        return -1;
+    }
+
+    for (i = 0; i < count; i++)
+    {
+        value |= ((bytes[*next / 8] >> (*next % 8)) & 1) << i;
+        (*next)++;
+    }
+
+    return value;
 }
 
-void WaitForSecond(int time)
+void writeVarint(uint8_t bytes[], long *size, uint32_t value)
 {
-// Check for platform as sleep function are different
-// in different OS
-#ifdef _WIN32
-    // Windows uses ms instead seconds
-    Sleep(time * 1000);
-#else
-    sleep(time);
-#endif
+    while (value >= 0x80)
+    {
+        bytes[*size] = (value & 0x7F) | 0x80;
+        (*size)++;
+        value >>= 7;
+    }
+
+    bytes[*size] = value;
+    (*size)++;
 }
 
-bool isFileExist(char fileName[])
+bool readVarint(uint8_t bytes[], long size, long *next, uint32_t *value)
 {
-// Different syntax of access on widows
-#ifdef _WIN32
-    return (_access(fileName, F_OK) != -1);
-#else
-    return (access(fileName, F_OK) != -1);
-#endif
+    int shift;
+
+    *value = 0;
+
+    // 5 bytes are enough for 32 bits
+    for (shift = 0; shift < 35 && *next < size; shift += 7)
+    {
+        *value |= (uint32_t)(bytes[*next] & 0x7F) << shift;
+        (*next)++;
+
+        if (!(bytes[*next - 1] & 0x80))
+        {
+            return true;
+        }
+    }
+
+    return false;
 }
 
-int RollADice()
+uint32_t archiveChecksum(uint8_t bytes[], long size)
 {
-    srand(time(NULL));
+    uint32_t hash = 2166136261u;
+    long i;
+
+    for (i = 0; i < size; i++)
+    {
+        hash = (hash ^ bytes[i]) * 16777619u;
+    }
 
-    return rand() % 6 + 1;
+    return hash;
 }
 
-Tokens getTokens(int i)
+ArchiveWriter *openArchiveWriter(char name[], Tournament *tournament)
 {
-    switch (playerIndex[whosTurn - 1] + 1)
+    ArchiveWriter *archive = calloc(1, sizeof(ArchiveWriter));
+    ArchiveHeader header;
+    bool isValid;
+    int i;
+
+    if (archive == NULL)
     {
-    case 1:
-        return red[i];
-        break;
-    case 2:
-        return green[i];
-        break;
-    case 3:
-        return yellow[i];
-        break;
-    case 4:
-        return blue[i];
-        break;
+        return NULL;
+    }
+
+    pthread_mutex_init(&archive->lock, NULL);
+    archive->file = fopen(name, "wb");
+    archive->numberOfBuffers = tournament->numberOfThreads;
+    isValid = archive->file != NULL;
+
+    // Memory stays the same however many games are played, one chunk and one game for every thread
+    for (i = 0; i < archive->numberOfBuffers && isValid; i++)
+    {
+        archive->buffer[i].records = malloc(ARCHIVE_CHUNK_SIZE + ARCHIVE_RECORD_SIZE);
+        archive->buffer[i].game.bytes = malloc(ARCHIVE_GAME_SIZE);
+        isValid = archive->buffer[i].records != NULL && archive->buffer[i].game.bytes != NULL;
+    }
 
-    default:
-        break;
+    if (isValid)
+    {
+        memset(&header, 0, sizeof(header));
+        strcpy(header.magic, ARCHIVE_MAGIC);
+        header.seed = tournament->seed;
+        memcpy(header.lineup, tournament->lineup, sizeof(header.lineup));
+        header.numberOfSeats = tournament->numberOfSeats;
+        header.numberOfGames = tournament->numberOfGames;
+
+        isValid = fwrite(&header, sizeof(header), 1, archive->file) == 1;
+    }
+
+    if (!isValid)
+    {
+        closeArchiveWriter(archive);
+        return NULL;
     }
+
+    return archive;
 }
 
-void moveToNextTurn()
+BitStream *startArchiveGame(ArchiveWriter *archive, int thread)
 {
-    count++;
-    whosTurn = count % (numberOfBots + 1) + 1;
+    archive->buffer[thread].game.numberOfBits = 0;
+    return &archive->buffer[thread].game;
 }
 
-void moveToken(int diceNum, Tokens temp, char posmov, int numOfToken)
+void addArchiveGame(ArchiveWriter *archive, int thread, int gameNumber, int turns)
 {
-    Tokens opponents[4]; //to storage the opponents
-    int i;
+    ArchiveBuffer *buffer = &archive->buffer[thread];
+    long length = (buffer->game.numberOfBits + 7) / 8;
+    long size;
 
-    for (i = 0; i < 4; i++)
+    // Games of a chunk follow each other, so stolen games start a new chunk
+    if (buffer->header.numberOfGames > 0 && gameNumber != buffer->header.firstGame + buffer->header.numberOfGames)
     {
-        opponents[i].col = 'n';
+        flushArchiveChunk(archive, thread);
     }
 
-    if (isTransitionToSafezone(temp, diceNum) || temp.safe)
+    if (buffer->header.numberOfGames == 0)
     {
-        opponents[0].col = 'n';
+        buffer->header.firstGame = gameNumber;
     }
-    else
+
+    size = buffer->header.numberOfBytes;
+    writeVarint(buffer->records, &size, turns);
+    writeVarint(buffer->records, &size, length);
+    memcpy(buffer->records + size, buffer->game.bytes, length);
+
+    buffer->header.numberOfBytes = size + length;
+    buffer->header.numberOfGames++;
+
+    if (buffer->header.numberOfBytes >= ARCHIVE_CHUNK_SIZE)
     {
-        getOpponents(temp, opponents, temp.pos + diceNum);
+        flushArchiveChunk(archive, thread);
     }
+}
 
-    if (posmov == 'm')
+void flushArchiveChunk(ArchiveWriter *archive, int thread)
+{
+    ArchiveChunk *header = &archive->buffer[thread].header;
+
+    if (header->numberOfGames == 0)
     {
-        //check if the token can move to safe zone or not
-        if (isTransitionToSafezone(temp, diceNum))
-        {
-            moveToSafeZone(numOfToken, diceNum);
-            clearOptionBox();
-            mvwprintw(options, 1, 1, "Token %c move %d step to safe zone", tokenShown(numOfToken), diceNum);
-            wrefresh(options);
-            WaitForSecond(1);
-        }
-        else
+        return;
+    }
+
+    strcpy(header->magic, ARCHIVE_CHUNK_MAGIC);
+    header->checksum = archiveChecksum(archive->buffer[thread].records, header->numberOfBytes);
+
+    pthread_mutex_lock(&archive->lock);
+
+    if (fwrite(header, sizeof(ArchiveChunk), 1, archive->file) != 1 ||
+        fwrite(archive->buffer[thread].records, 1, header->numberOfBytes, archive->file) != (size_t)header->numberOfBytes)
+    {
+        archive->isFailed = true;
+    }
+
+    pthread_mutex_unlock(&archive->lock);
+
+    header->numberOfGames = 0;
+    header->numberOfBytes = 0;
+}
+
+bool closeArchiveWriter(ArchiveWriter *archive)
+{
+    bool isWritten;
+    int i;
+
+    if (archive->file != NULL)
+    {
+        for (i = 0; i < archive->numberOfBuffers; i++)
         {
-            //check if there is opponents with modul isThere opponents
-            if ((opponents[0].col != temp.col) && (opponents[0].col != 'n'))
+            if (archive->buffer[i].records != NULL)
             {
-                //initialize the index of opponent
-                int op = whosOpponents(opponents[0].col);
-                int choice, opChoice; //choice is choosen by player whose take turn and opChoice is choosen by opponents
-                int whosWin;          // Storage to show who won
+                flushArchiveChunk(archive, i);
+            }
+        }
 
-                do
-                {
-                    // Clear out the option box
-                    clearOptionBox();
+        archive->isFailed |= fclose(archive->file) != 0;
+    }
+    isWritten = archive->file != NULL && !archive->isFailed;
+    pthread_mutex_destroy(&archive->lock);
 
-                    if (!players[playerIndex[whosTurn - 1]].comp && players[op].comp) //if whos take turn is user and opponents is bot
-                    {
-                        // Get user input on suit menu
-                        suitMenu(&choice);
-                        // Do random suit for the bot
-                        opChoice = suitRandom();
-                    }
-                    else if (players[playerIndex[whosTurn - 1]].comp && !(players[op].comp)) //if whos take turn is bot and opponents is user
-                    {
-                        choice = suitRandom();
-                        suitMenu(&opChoice);
-                    }
-                    else if (players[playerIndex[whosTurn - 1]].comp && players[op].comp) //if both of whos take turn and opponents is bot
-                    {
-                        choice = suitRandom();
-                        WaitForSecond(1);
-                        opChoice = suitRandom();
-                    }
+    for (i = 0; i < archive->numberOfBuffers; i++)
+    {
+        free(archive->buffer[i].records);
+        free(archive->buffer[i].game.bytes);
+    }
+    free(archive);
 
-                    // Check who won
-                    whosWin = suitCheck(choice, opChoice);
+    return isWritten;
+}
 
-                    if (whosWin == 0)
-                    {
-                        clearOptionBox();
-                        if ((!players[playerIndex[whosTurn - 1]].comp) || !(players[op].comp))
-                        {
-                            printToOptionBox("A draw!", 1, 1);
-                            WaitForSecond(1);
-                        }
-                    }
+bool openArchive(char name[], ArchiveReader *reader)
+{
+    memset(reader, 0, sizeof(ArchiveReader));
+    reader->file = fopen(name, "rb");
 
-                } while (whosWin == 0);
+    if (reader->file == NULL)
+    {
+        return false;
+    }
 
-                //if win then token moveForward opponents moveToHome and vice versa
+    reader->records = malloc(ARCHIVE_CHUNK_SIZE + ARCHIVE_RECORD_SIZE);
 
-                if (whosWin == 1) //if the player that take turn win
-                {
-                    clearOptionBox();
-                    if (!players[playerIndex[whosTurn - 1]].comp && players[op].comp)
-                    {
-                        printToOptionBox("You've won!", 1, 1);
-                    }
-                    else if (players[playerIndex[whosTurn - 1]].comp && !(players[op].comp))
-                    {
-                        printToOptionBox("You've lost!", 1, 1);
-                    }
+    if (reader->records == NULL || fread(&reader->header, sizeof(ArchiveHeader), 1, reader->file) != 1 ||
+        strcmp(reader->header.magic, ARCHIVE_MAGIC) != 0 || reader->header.numberOfSeats < 2 || reader->header.numberOfSeats > 4)
+    {
+        closeArchive(reader);
+        return false;
+    }
 
-                    WaitForSecond(1);
-                    // Move the player token forward
-                    moveForward(diceNum, numOfToken);
-                    // Add the kill
-                    players[playerIndex[whosTurn - 1]].kill++;
-                    for (int i = 0; i < 4; i++)
-                    {
-                        if (opponents[i].col != 'n')
-                        {
-                            toHomeBase(opponents[i].ind, op + 1);
-                        }
-                    }
-                }
-                else
-                {
-                    clearOptionBox();
-                    if (!players[playerIndex[whosTurn - 1]].comp && players[op].comp)
-                    {
-                        printToOptionBox("You've lost!", 1, 1);
-                    }
-                    else if (players[playerIndex[whosTurn - 1]].comp && !(players[op].comp))
-                    {
-                        printToOptionBox("You've won!", 1, 1);
-                    }
-                    WaitForSecond(1);
+    return true;
+}
 
-                    // Add the kill to opponents of the player currently playing
-                    players[op].kill++;
-                    toHomeBase(numOfToken, playerIndex[whosTurn - 1] + 1);
-                }
-            }
-            else
-            {
-                clearOptionBox();
-                moveForward(diceNum, numOfToken);
-                mvwprintw(options, 1, 1, "Token %c move %d step to board no-%d", tokenShown(numOfToken), diceNum, temp.pos + diceNum);
-                wrefresh(options);
-                WaitForSecond(1);
-            }
-        }
+bool decodeArchiveTurn(GameContext *game, uint8_t bytes[], long size, long *next, uint8_t events[], long *numberOfEvents)
+{
+    char posmov[4];      // Storage for possible move
+    Tokens temp[4];      // Temporary token storage for the current player
+    Tokens opponents[4]; // Opponents on the destination of the moved token
+    int diceRoll;        // Temporary storage for diceroll
+    int numberOfSix = 0; // Count the number of the six in the dice roll
+    int numOfToken;      // Number of token that's moved
+    int isWon;           // Outcome of the suit, 1 if the player won it
+    int whosWin;         // Result of the suit as suitCheck gives it
+    int tempcount;       // Counting the possibilities of stuck
+    int i;               // Looping
+
+    // Same as headlessTurn, but the rolls and the choices are read instead of played
+    diceRoll = readBits(bytes, size, next, ARCHIVE_DICE_BITS);
+
+    if (diceRoll < 1 || diceRoll > 6)
+    {
+        return false;
     }
-    else if (posmov == 'o')
+    events[(*numberOfEvents)++] = (REPLAY_DICE << 6) | diceRoll;
+
+    while (numberOfSix < 3)
     {
-        switch (playerIndex[whosTurn - 1] + 1)
+        tempcount = 0;
+
+        for (i = 0; i < 4; i++)
         {
-        case 1:
-            getOpponents(temp, opponents, 1);
-            break;
+            temp[i] = getTokens(game, i);
+            posmov[i] = possibleMove(diceRoll, temp[i].pos, temp[i].safe);
 
-        case 2:
-            getOpponents(temp, opponents, 14);
-            break;
+            if (posmov[i] == 's')
+                tempcount++;
+        }
 
-        case 3:
-            getOpponents(temp, opponents, 27);
+        // No tokens can be moved, the turn is over
+        if (tempcount == 4)
+        {
             break;
+        }
 
-        case 4:
-            getOpponents(temp, opponents, 40);
-            break;
+        numOfToken = readBits(bytes, size, next, ARCHIVE_TOKEN_BITS);
 
-        default:
-            break;
+        if (numOfToken < 0 || posmov[numOfToken] == 's')
+        {
+            return false;
         }
+        events[(*numberOfEvents)++] = (REPLAY_TOKEN << 6) | numOfToken;
 
-        clearOptionBox();
-        mvwprintw(options, 1, 1, "Token %c enter the board", tokenShown(numOfToken));
-        wrefresh(options);
-        WaitForSecond(1);
+        getMoveOpponents(game, diceRoll, temp[numOfToken], posmov[numOfToken], opponents);
+        whosWin = 0;
 
-        //check if there is opponents with modul isThere opponents
-        if ((opponents[0].col != temp.col) && (opponents[0].col != 'n'))
+        if (isCapture(temp[numOfToken], opponents))
         {
-            //initialize the index of opponent
-            int op = whosOpponents(opponents[0].col);
-            int choice, opChoice; //choice is choosen by player whose take turn and opChoice is choosen by opponents
-            int whosWin;          // Storage to show who won
+            isWon = readBits(bytes, size, next, ARCHIVE_SUIT_BITS);
 
-            do
+            if (isWon < 0)
             {
-                // Clear out the option box
-                clearOptionBox();
-
-                if (!players[playerIndex[whosTurn - 1]].comp && players[op].comp) //if whos take turn is user and opponents is bot
-                {
-                    // Get user input on suit menu
-                    suitMenu(&choice);
-                    // Do random suit for the bot
-                    opChoice = suitRandom();
-                }
-                else if (players[playerIndex[whosTurn - 1]].comp && !(players[op].comp)) //if whos take turn is bot and opponents is user
-                {
-                    choice = suitRandom();
-                    suitMenu(&opChoice);
-                }
-                else if (players[playerIndex[whosTurn - 1]].comp && players[op].comp) //if both of whos take turn and opponents is bot
-                {
-                    choice = suitRandom();
-                    WaitForSecond(1);
-                    opChoice = suitRandom();
-                }
-
-                // Check who won
-                whosWin = suitCheck(choice, opChoice);
+                return false;
+            }
 
-                if (whosWin == 0)
-                {
-                    clearOptionBox();
-                    if ((!players[playerIndex[whosTurn - 1]].comp) || !(players[op].comp))
-                    {
-                        printToOptionBox("A draw!", 1, 1);
-                        WaitForSecond(1);
-                    }
-                }
+            // The draws before the outcome are not archived, one pair of choices gives the same outcome
+            whosWin = isWon ? 1 : 2;
+            events[(*numberOfEvents)++] = (REPLAY_SUIT << 6) | 1;
+            events[(*numberOfEvents)++] = (REPLAY_SUIT << 6) | (isWon ? 3 : 2);
+        }
 
-            } while (whosWin == 0);
+        applyMove(game, diceRoll, temp[numOfToken], posmov[numOfToken], numOfToken, opponents, whosWin);
 
-            //if win then token moveForward opponents moveToHome and vice versa
+        if (diceRoll == 6)
+        {
+            numberOfSix++;
 
-            if (whosWin == 1) //if the player that take turn win
+            // The roll after the third six is not played, so it's not archived
+            if (numberOfSix < 3)
             {
-                clearOptionBox();
-                if (!players[playerIndex[whosTurn - 1]].comp && players[op].comp)
-                {
-                    printToOptionBox("You've won!", 1, 1);
-                }
-                else if (players[playerIndex[whosTurn - 1]].comp && !(players[op].comp))
-                {
-                    printToOptionBox("You've lost!", 1, 1);
-                }
+                diceRoll = readBits(bytes, size, next, ARCHIVE_DICE_BITS);
 
-                WaitForSecond(1);
-                // Move the winner token out of the homebase
-                outFromHomeBase(numOfToken);
-                // Add the kill
-                players[playerIndex[whosTurn - 1]].kill++;
-                for (int i = 0; i < 4; i++)
-                {
-                    if (opponents[i].col != 'n')
-                    {
-                        toHomeBase(opponents[i].ind, op + 1);
-                    }
-                }
-            }
-            else
-            {
-                clearOptionBox();
-                if (!players[playerIndex[whosTurn - 1]].comp && players[op].comp)
+                if (diceRoll < 1 || diceRoll > 6)
                 {
-                    printToOptionBox("You've lost!", 1, 1);
+                    return false;
                 }
-                else if (players[playerIndex[whosTurn - 1]].comp && !(players[op].comp))
-                {
-                    printToOptionBox("You've won!", 1, 1);
-                }
-                WaitForSecond(1);
-
-                // Add the kill
-                players[op].kill++;
-                toHomeBase(numOfToken, playerIndex[whosTurn - 1] + 1);
+                events[(*numberOfEvents)++] = (REPLAY_DICE << 6) | diceRoll;
             }
         }
         else
         {
-            outFromHomeBase(numOfToken);
+            break;
         }
     }
 
-    // Add number of move
-    switch (temp.col)
-    {
-    case 'r':
-        players[0].move++;
-        break;
-
-    case 'g':
-        players[1].move++;
-        break;
-
-    case 'y':
-        players[2].move++;
-        break;
-
-    case 'b':
-        players[3].move++;
-        break;
-    }
-
-    // If the bot is complete, the player rank will go down
-    if (isItWin(playerIndex[whosTurn - 1]) && players[playerIndex[whosTurn - 1]].comp)
-    {
-        position++;
-    }
-
-    // End the turn
+    events[(*numberOfEvents)++] = (REPLAY_TURN << 6);
+    return true;
 }
 
-void getPossibleMove(char posmov[], Tokens temp[], int diceNum)
+int readArchiveGame(ArchiveReader *reader, GameContext *game, uint8_t events[], long *numberOfEvents, int *gameNumber, int rank[4])
 {
-    // Clear out the option box before
-    clearOptionBox();
-    // Labeling
-    printToOptionBox("Tokens that can be move : ", 1, 1);
-    int j = 0;
-    for (int i = 0; i < 4; i++)
+    ArchiveChunk *chunk = &reader->chunk;
+    int botIndexes[4]; // Bot of every colour
+    uint32_t turns;    // Turns of the game
+    uint32_t length;   // Size of the bits of the game
+    size_t size;       // Size of the chunk header that's read
+    long next = 0;     // Next bit of the game
+    int place = 1;     // Next finishing place
+    int i;
+
+    // The next chunk is read once every game of this one is read
+    while (reader->gamesLeft == 0)
     {
-        // Check for possible move
-        posmov[i] = possibleMove(diceNum, temp[i].pos, temp[i].safe);
-        if (posmov[i] == 's')
-        {
-            // If tokens are stuck continue
-            j++;
-            continue;
-        }
-        else
+        size = fread(chunk, 1, sizeof(ArchiveChunk), reader->file);
+
+        if (size == 0)
         {
-            // Show tokens that can be shown
-            wprintw(options, "%c ", tokenShown(i));
-            wrefresh(options);
-            /*
-                Call the input here
-            */
+            return 0;
         }
-        if (j == 4)
+
+        if (size != sizeof(ArchiveChunk) || strcmp(chunk->magic, ARCHIVE_CHUNK_MAGIC) != 0 || chunk->numberOfGames < 0 ||
+            chunk->numberOfBytes < 0 || chunk->numberOfBytes > ARCHIVE_CHUNK_SIZE + ARCHIVE_RECORD_SIZE ||
+            fread(reader->records, 1, chunk->numberOfBytes, reader->file) != (size_t)chunk->numberOfBytes ||
+            archiveChecksum(reader->records, chunk->numberOfBytes) != chunk->checksum)
         {
-            // If there's no token that can be moved
-            printToOptionBox("There's no tokens that can be move", strlen("Tokens that can be move : ") + 1, 1);
-            //end the turn
+            return -1;
         }
-    }
-}
 
-int getNumOfToken(char posmov[])
-{
-    int numOfToken;
-    char token;
+        reader->next = 0;
+        reader->gamesLeft = chunk->numberOfGames;
+        reader->numberOfChunks++;
+    }
 
-    // Label the input
-    printToOptionBox("Choose the token : ", 2, 1);
-    // In case the cursor was set not to be shown
-    curs_set(1);
-    // Also show the echo of the user input
-    echo();
-    // Move the cursor
-    wmove(options, 2, strlen("Choose the token : "));
-    // Get the input
-    wscanw(options, "%c", &token);
-    numOfToken = tokenCharToInt(token);
+    *gameNumber = chunk->firstGame + chunk->numberOfGames - reader->gamesLeft;
 
-    // Check the validity
-    while (!validateInputToken(numOfToken) || ((posmov[numOfToken] == 's')))
+    if (!readVarint(reader->records, chunk->numberOfBytes, &reader->next, &turns) ||
+        !readVarint(reader->records, chunk->numberOfBytes, &reader->next, &length) ||
+        turns > MAX_HEADLESS_TURN || length > chunk->numberOfBytes - reader->next)
     {
-        wmove(options, 2, 0);
-        // Clear the line to show not valid
-        clrtoeol();
-        // Show non validity
-        printToOptionBox("The input isn't valid, please reenter the tokens!!", 2, 1);
-        // Get input
-        printToOptionBox("Choose the token : ", 3, 1);
-        wmove(options, 3, strlen("Choose the token : "));
-        wscanw(options, "%c", &token);
-        numOfToken = tokenCharToInt(token);
+        return -1;
     }
 
-    return numOfToken;
-}
+    // The game is started the same as playTournamentGame started it
+    lineupColours(reader->header.lineup, reader->header.numberOfSeats, *gameNumber, botIndexes);
+    initHeadlessPlayerData(game, botIndexes, splitSeed(reader->header.seed, *gameNumber));
+    *numberOfEvents = 0;
 
-char possibleMove(int diceNum, int x, bool safe)
-{
-    //There's only three possibilities for token, m for move, o for out from base, s for stuck
-    if ((diceNum == 6 && x == 0) && !safe)
-    {
-        return 'o'; //if the token is in the home and can move to board
-    }
-    else if ((diceNum != 6 && x == 0) && !safe)
-    {
-        return 's'; //if the token is in the home and can't move to board
-    }
-    else if ((x != 0) && !safe)
-    {
-        return 'm'; //if the token is in the board
-    }
-    else if ((diceNum > (6 - x)) && safe)
+    for (i = 0; i < 4; i++)
     {
-        return 's'; //if the token is in the safe zone and the dice number is bigger than required step to finish
+        rank[i] = 0;
     }
-    else
+
+    for (i = 0; i < (int)turns; i++)
     {
-        return 'm'; //if the token is in the safe zone and the dice number isn't bigger than required step to finish
+        if (!decodeArchiveTurn(game, reader->records + reader->next, length, &next, events, numberOfEvents))
+        {
+            return -1;
+        }
+
+        rankHeadlessTurn(game, rank, &place);
+        moveToNextTurn(game);
     }
-    return '0';
+
+    rankLastPlayer(game, rank, place);
+
+    reader->next += length;
+    reader->gamesLeft--;
+
+    // Every bit of the record is used, except the padding of the last byte
+    return (next + 7) / 8 == length ? 1 : -1;
 }
 
-bool validateInputToken(int x)
+void closeArchive(ArchiveReader *reader)
 {
-    if (x >= 0 && x < 4)
+    if (reader->file != NULL)
     {
-        return true;
+        fclose(reader->file);
+        reader->file = NULL;
     }
-    else
-        return false;
+
+    free(reader->records);
+    reader->records = NULL;
 }
 
-void moveForward(int diceNum, int numOfToken)
+int readArchiveCommand(int argc, char *argv[])
 {
-    switch (playerIndex[whosTurn - 1] + 1)
+    char summary[SUMMARY_LENGTH];
+    ArchiveReader reader;
+    Tournament *tournament;
+    GameContext game, replay;
+    uint8_t *events;           // Replay events of the game that's read
+    long numberOfEvents;
+    long next;                 // Next event of the shown game
+    int shownGame = -1;        // Game whose turns are printed, -1 for the statistic of every game
+    int botIndexes[4];         // Bot of every colour of the shown game
+    int rank[4];               // Finishing place of every colour
+    int gameNumber, result, i;
+    bool isShown = false;      // The shown game is in the archive
+    bool isValid = argc > 0;
+
+    // The tournament is too big to be put on the stack
+    tournament = malloc(sizeof(Tournament));
+    events = malloc(ARCHIVE_EVENTS_SIZE);
+
+    if (tournament == NULL || events == NULL)
     {
-    case 1:
-        red[numOfToken].pos += diceNum;
-        red[numOfToken].relpos += diceNum;
-        if (red[numOfToken].pos > 52)
+        printf("Not enough memory to read the archive\n");
+        free(tournament);
+        free(events);
+        return 1;
+    }
+
+    memset(tournament, 0, sizeof(Tournament));
+    tournament->format = OUTPUT_CSV;
+    tournament->output = stdout;
+    tournament->numberOfThreads = 1;
+
+    for (i = 1; i < argc && isValid; i++)
+    {
+        if (i + 1 >= argc)
         {
-            red[numOfToken].pos -= 52;
+            isValid = false;
         }
-        break;
-    case 2:
-        green[numOfToken].pos += diceNum;
-        green[numOfToken].relpos += diceNum;
-        if (green[numOfToken].pos > 52)
+        else if (strcmp(argv[i], "--game") == 0)
         {
-            green[numOfToken].pos -= 52;
+            shownGame = atoi(argv[++i]);
+            isValid = shownGame >= 0;
         }
-        break;
-    case 3:
-        yellow[numOfToken].pos += diceNum;
-        yellow[numOfToken].relpos += diceNum;
-        if (yellow[numOfToken].pos > 52)
+        else if (strcmp(argv[i], "--format") == 0)
         {
-            yellow[numOfToken].pos -= 52;
+            i++;
+            tournament->format = strcmp(argv[i], "json") == 0 ? OUTPUT_JSON : OUTPUT_CSV;
+            isValid = strcmp(argv[i], "json") == 0 || strcmp(argv[i], "csv") == 0;
         }
-        break;
-    case 4:
-        blue[numOfToken].pos += diceNum;
-        blue[numOfToken].relpos += diceNum;
-        if (blue[numOfToken].pos > 52)
+        else
         {
-            blue[numOfToken].pos -= 52;
+            isValid = false;
         }
-        break;
-    default:
-        break;
     }
-}
 
-void toHomeBase(int numOfToken, int index)
-{
-    switch (index)
+    if (!isValid)
     {
-    case 1:
-        red[numOfToken].pos = 0;
-        red[numOfToken].relpos = 0;
-        break;
-    case 2:
-        green[numOfToken].pos = 0;
-        green[numOfToken].relpos = 0;
-        break;
-    case 3:
-        yellow[numOfToken].pos = 0;
-        yellow[numOfToken].relpos = 0;
-        break;
-    case 4:
-        blue[numOfToken].pos = 0;
-        blue[numOfToken].relpos = 0;
-        break;
-    default:
-        break;
+        printf("Usage : ludo --read-archive <archive> [--game <game number>] [--format csv|json]\n");
+        free(tournament);
+        free(events);
+        return 1;
     }
-}
 
-void outFromHomeBase(int numOfToken)
-{
-    switch (playerIndex[whosTurn - 1] + 1)
+    if (!openArchive(argv[0], &reader))
     {
-    case 1:
-        red[numOfToken].pos = 1;
-        red[numOfToken].relpos = 1;
-        break;
-    case 2:
-        green[numOfToken].pos = 14;
-        green[numOfToken].relpos = 1;
-        break;
-    case 3:
-        yellow[numOfToken].pos = 27;
-        yellow[numOfToken].relpos = 1;
-        break;
-    case 4:
-        blue[numOfToken].pos = 40;
-        blue[numOfToken].relpos = 1;
-        break;
-    default:
-        break;
+        printf("%s is not an archive\n", argv[0]);
+        free(tournament);
+        free(events);
+        return 1;
     }
-}
 
-void moveToSafeZone(int numOfToken, int diceNum)
-{
-    switch (playerIndex[whosTurn - 1] + 1)
+    tournament->seed = reader.header.seed;
+    tournament->numberOfSeats = reader.header.numberOfSeats;
+    memcpy(tournament->lineup, reader.header.lineup, sizeof(tournament->lineup));
+
+    while ((result = readArchiveGame(&reader, &game, events, &numberOfEvents, &gameNumber, rank)) == 1)
     {
-    case 1:
-        red[numOfToken].pos = (red[numOfToken].pos + diceNum) - 51;
-        red[numOfToken].relpos = red[numOfToken].pos;
-        red[numOfToken].safe = true;
-        break;
-    case 2:
-        green[numOfToken].pos = (green[numOfToken].pos + diceNum) - 12;
-        green[numOfToken].relpos = green[numOfToken].pos;
-        green[numOfToken].safe = true;
-        break;
-    case 3:
-        yellow[numOfToken].pos = (yellow[numOfToken].pos + diceNum) - 25;
-        yellow[numOfToken].relpos = yellow[numOfToken].pos;
-        yellow[numOfToken].safe = true;
-        break;
-    case 4:
-        blue[numOfToken].pos = (blue[numOfToken].pos + diceNum) - 38;
-        blue[numOfToken].relpos = blue[numOfToken].pos;
-        blue[numOfToken].safe = true;
-        break;
-    default:
-        break;
+        tournament->numberOfGames++;
+        addTournamentGame(tournament, &game, gameNumber, 0, rank);
+
+        if (gameNumber == shownGame)
+        {
+            // Same as a replay log, the events are played again from the start of the game
+            lineupColours(tournament->lineup, tournament->numberOfSeats, gameNumber, botIndexes);
+            initHeadlessPlayerData(&replay, botIndexes, splitSeed(tournament->seed, gameNumber));
+            next = 0;
+            isShown = true;
+
+            while (replayTurn(&replay, events, numberOfEvents, &next, summary, false) == 1)
+            {
+                printf("%5d %s\n", replay.count + 1, summary);
+                moveToNextTurn(&replay);
+            }
+        }
     }
-}
 
-void showOptionBox()
-{
-    // Initialized the box under the board
-    options = newWindow(7, 58, 1, 31);
+    if (result == -1)
+    {
+        printf("Chunk %ld of %s is broken\n", reader.numberOfChunks, argv[0]);
+    }
+    else if (shownGame == -1)
+    {
+        showTournamentResult(tournament);
+    }
+    else if (!isShown)
+    {
+        printf("Game %d is not in %s\n", shownGame, argv[0]);
+        result = -1;
+    }
 
-    // Create the border of the box
-    wborder(options, 0, 0, 0, 0, 0, 0, 0, 0);
-    wrefresh(options);
+    closeArchive(&reader);
+    free(tournament);
+    free(events);
+    return result == -1 ? 1 : 0;
 }
 
-void destroyOptionBox()
+int botHans(GameContext *game, char posmov[], Tokens temp[], int diceNum)
 {
-    // Clean up the border of the option box
-    wborder(options, ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ');
+    //moving the token that near opponents
+    for (int i = 0; i < 4; i++)
+    {
+        if (posmov[i] == 'o')
+        {
+            switch (game->playerIndex[game->whosTurn - 1] + 1)
+            {
+            case 1:
+                if (isBotHasOpponents(game, temp[i], 1))
+                {
+                    return i;
+                }
+                break;
 
-    // Remove the content
-    werase(options);
+            case 2:
+                if (isBotHasOpponents(game, temp[i], 14))
+                {
+                    return i;
+                }
+                break;
 
-    // Refresh it
-    wrefresh(options);
+            case 3:
+                if (isBotHasOpponents(game, temp[i], 27))
+                {
+                    return i;
+                }
+            case 4:
+                if (isBotHasOpponents(game, temp[i], 51))
+                {
+                    return i;
+                }
+                break;
 
-    // Remove it
-    delwin(options);
-}
+            default:
+                break;
+            }
+        }
 
-void clearOptionBox()
-{
-    // Clear out the box
-    werase(options);
+        else if (posmov[i] == 'm')
+        {
+            if (isBotHasOpponents(game, temp[i], temp[i].pos + diceNum))
+            {
+                return i;
+            }
+        }
+    }
 
-    // Redraw the box as erasing it also remove the border
-    wborder(options, 0, 0, 0, 0, 0, 0, 0, 0);
+    //moving token that can out from base
+    for (int i = 0; i < 4; i++)
+    {
+        if (posmov[i] == 'o')
+        {
+            return i;
+        }
+    }
 
-    // Refresh the box
-    wrefresh(options);
-}
+    //moving the token in safe zone
 
-int suitCheck(int player1, int player2)
-{
-    // If they choose the same option then it's a draw
-    if (player1 == player2)
+    int inSafeZone = 0, numOfToken = -1;
+
+    for (int i = 0; i < 4; i++)
     {
-        return 0;
+        if (posmov[i] == 'm')
+        {
+            if (temp[i].safe)
+            {
+                if (inSafeZone < temp[i].pos)
+                {
+                    inSafeZone = temp[i].pos;
+                    numOfToken = i;
+                }
+            }
+        }
     }
-    // Kertas vs Gunting, gunting won
-    else if (player1 == 1 && player2 == 2)
-        return 2;
-    // Kertas vs Batu, batu won
-    else if (player1 == 1 && player2 == 3)
-        return 1;
-    // Gunting vs Kertas, gunting won
-    else if (player1 == 2 && player2 == 1)
-        return 1;
-    // Gunting vs Batu, batu won
-    else if (player1 == 2 && player2 == 3)
-        return 2;
-    // Batu vs Kertas, kertas won
-    else if (player1 == 3 && player2 == 1)
-        return 1;
-    // Batu vs Gunting, batu won
-    else if (player1 == 3 && player2 == 2)
-        return 1;
+
+    if (numOfToken != -1)
+    {
+        return numOfToken;
+    }
+
+    //moving the biggest relpos
+    int relPos = 0;
+    for (int i = 0; i < 4; i++)
+    {
+        if (posmov[i] == 'm')
+        {
+            if (relPos < temp[i].relpos)
+            {
+                relPos = temp[i].relpos;
+                numOfToken = i;
+            }
+        }
+    }
+
+    return numOfToken;
 }
 
-void suitMenu(int *choice)
+bool isBotHasOpponents(GameContext *game, Tokens token, int index)
 {
-    // Make sure the option box is clear of content
-    clearOptionBox();
+    // Oppponents is there only if they're not the same colour, in one of the
+    // 6 positions starting from index and not in the safezone
+    return ringWindow(opponentsRing(game, token), index, 6) != 0;
+}
 
-    // Positioning and looping
-    int i, highlight = 0, position;
+void showLabel(GameContext *game)
+{
+    int i;
+    char label[15];
+    for (i = 0; i < 4; i++)
+    {
+        if (game->players[i].col == 'n')
+        {
+            continue;
+        }
+        else
+        {
+            if (!game->players[i].comp)
+            {
+                strcpy(label, "You");
+            }
+            else
+            {
+                switch (game->players[i].comptype)
+                {
+                case 'j':
+                    strcpy(label, "Jorgen");
+                    break;
+
+                case 'h':
+                    strcpy(label, "Hans");
+                    break;
+
+                case 'm':
+                    strcpy(label, "Muller");
+                    break;
+
+                case 'k':
+                    strcpy(label, "Klaus");
+                    break;
+
+                case 'f':
+                    strcpy(label, "Franz");
+                    break;
+
+                case 'w':
+                    strcpy(label, "Werner");
+                    break;
+                }
+            }
+
+            wattrset(board, COLOR_PAIR(BOARD_BLACK));
+
+            switch (game->players[i].col)
+            {
+            case 'r':
+                mvwprintw(board, cellRect[0][10].row + 1, cellRect[0][10].col, label);
+                break;
 
-    // Options for the user
-    char option[3][10] = {"Kertas", "Gunting", "Batu"};
-    char item[9];
-    char ch;
+            case 'g':
+                mvwprintw(board, cellRect[9][10].row + 1, cellRect[9][10].col, label);
+                break;
 
-    // Enable keypad mode for key up and down
-    keypad(options, true);
+            case 'y':
+                mvwprintw(board, cellRect[9][1].row + 1, cellRect[9][1].col, label);
+                break;
 
-    // Make sure what has been entered is not shown
-    noecho();
+            case 'b':
+                mvwprintw(board, cellRect[0][1].row + 1, cellRect[0][1].col, label);
+                break;
 
-    // Hide the cursor
-    curs_set(0);
+            default:
+                break;
+            }
+        }
+    }
+}
 
-    // Show label to informed the user
-    mvwprintw(options, 1, 1, "Pilih opsi untuk suit");
-    position = strlen("Pilih opsi untuk suit");
+double colourCaptureChance(int behind[4], int numberOfTokens, int spare, int home, int progress, int rollsLeft)
+{
+    int moved[4];      // Distances after a six
+    uint32_t near = 0; // Bit d is set if a roll of d captures the token
+    double chance = 0;
+    double best, value;
+    int diceNum, i;
 
-    // Loop until has been inputed
-    while (1)
+    for (i = 0; i < numberOfTokens; i++)
     {
-        // Show the options
-        for (i = 0; i < 4; i++)
-        {
-            // Show the highlighted options with highlights
-            if (i == highlight)
-                wattron(options, A_REVERSE);
+        near |= 1 << behind[i];
+    }
 
-            mvwprintw(options, i + 1, position + 1, option[i]);
+    // Out of the home base right on the token also captures, even with the third six
+    if (home > 0 && progress == 1)
+    {
+        near |= 1 << 6;
+    }
 
-            if (i == highlight)
-                wattroff(options, A_REVERSE);
+    for (diceNum = 1; diceNum <= 6; diceNum++)
+    {
+        if (near & (1 << diceNum))
+        {
+            chance += 1;
         }
+    }
 
-        // Get user input
-        ch = wgetch(options);
-
-        if (ch == (char)KEY_UP)
+    // Any other roll ends the turn, the third six too
+    if ((near & (1 << 6)) == 0 && rollsLeft > 0)
+    {
+        // Every token that can be moved with the six is tried
+        best = 0;
+        if (spare > 0)
         {
-            highlight--;
-            highlight = (highlight < 0) ? 2 : highlight;
+            best = colourCaptureChance(behind, numberOfTokens, spare - 1, home, progress, rollsLeft - 1);
         }
-        else if (ch == (char)KEY_DOWN)
+        for (i = 0; i < numberOfTokens; i++)
         {
-            highlight++;
-            highlight = (highlight > 2) ? 0 : highlight;
+            memcpy(moved, behind, sizeof(moved));
+
+            if (behind[i] > 6)
+            {
+                moved[i] -= 6;
+                value = colourCaptureChance(moved, numberOfTokens, spare, home, progress, rollsLeft - 1);
+            }
+            else
+            {
+                // Past the token, it can only take the next sixes
+                moved[i] = moved[numberOfTokens - 1];
+                value = colourCaptureChance(moved, numberOfTokens - 1, spare + sixMovesLeft(progress - behind[i] + 6),
+                                            home, progress, rollsLeft - 1);
+            }
+            best = value > best ? value : best;
         }
-        else if (ch == 10) // Somehow the usage of KEY_ENTER doesn't work, so char 10 is used instead
+        if (home > 0)
         {
-            *choice = highlight + 1;
-            break;
+            // Out on the start, which is close enough to the token to come
+            memcpy(moved, behind, sizeof(moved));
+            moved[numberOfTokens] = progress - 1;
+            value = colourCaptureChance(moved, numberOfTokens + 1, spare, home - 1, progress, rollsLeft - 1);
+            best = value > best ? value : best;
         }
-    }
-}
-
-int suitRandom()
-{
-    srand(time(NULL));
-
-    return rand() % 3 + 1;
-}
 
-void printToOptionBox(char input[], int x, int y)
-{
-    // Print it
-    mvwprintw(options, x, y, input);
+        chance += best;
+    }
 
-    // Refresh the box
-    wrefresh(options);
+    return chance / 6;
 }
 
-void positionToCoordinate(Tokens token, int *x, int *y)
+double cachedCaptureChance(int behind[4], int numberOfTokens, int spare, int home, int progress)
 {
-    if (token.safe)
+    CaptureEntry *entry;
+    int sorted[4] = {0, 0, 0, 0};
+    uint32_t key;
+    int i, j, swap;
+
+    // Same key whatever the order of the tokens, at most two tokens come out of the home base before the last roll
+    memcpy(sorted, behind, numberOfTokens * sizeof(int));
+    for (i = 1; i < numberOfTokens; i++)
     {
-        switch (token.col)
+        for (j = i; j > 0 && sorted[j] > sorted[j - 1]; j--)
         {
-        case 'r':
-            // Red Safezone are in one collumn
-            *y = 7;
-            // The rows are the same as the position in the safezone
-            *x = token.pos;
-            break;
-
-        case 'g':
-            // Green Safezone are in one row
-            *x = 7;
-            // The safezone are in the right side of the board
-            *y = 14 - token.pos;
-            break;
-
-        case 'y':
-            // Yellow Safezone are in one collumn
-            *y = 7;
-            // The rows are int the bottom part of the board
-            *x = 14 - token.pos;
-            break;
-
-        case 'b':
-            // Blue Safezone are in one row
-            *x = 7;
-            // The collumn are the same as the position in the safezone
-            *y = token.pos;
-            break;
+            swap = sorted[j];
+            sorted[j] = sorted[j - 1];
+            sorted[j - 1] = swap;
         }
     }
-    else
-    {
-        // Search for the position in the rows
-        switch (token.pos)
-        {
-        case 50:
-        case 51:
-        case 52:
-            *x = 0;
-            break;
+    key = sorted[0] | sorted[1] << 5 | sorted[2] << 10 | sorted[3] << 15 | spare << 20 | (home < 2 ? home : 2) << 22 |
+          (uint32_t)progress << 24;
 
-        case 49:
-        case 1:
-            *x = 1;
-            break;
+    entry = &getCaptureCache()[(key * 2654435761U) >> 20 & (CAPTURE_CACHE_SIZE - 1)];
+    if (entry->key != key)
+    {
+        entry->key = key;
+        entry->chance = colourCaptureChance(behind, numberOfTokens, spare, home, progress, 2);
+    }
 
-        case 48:
-        case 2:
-            *x = 2;
-            break;
+    return entry->chance;
+}
 
-        case 47:
-        case 3:
-            *x = 3;
-            break;
+pthread_key_t captureCacheKey;
+pthread_once_t captureCacheOnce = PTHREAD_ONCE_INIT;
 
-        case 46:
-        case 4:
-            *x = 4;
-            break;
+void createCaptureCacheKey()
+{
+    // The cache is freed when its thread exits
+    pthread_key_create(&captureCacheKey, free);
+}
 
-        case 45:
-        case 5:
-            *x = 5;
-            break;
+CaptureEntry *getCaptureCache()
+{
+    CaptureEntry *cache;
 
-        case 39:
-        case 40:
-        case 41:
-        case 42:
-        case 43:
-        case 44:
-        case 6:
-        case 7:
-        case 8:
-        case 9:
-        case 10:
-        case 11:
-            *x = 6;
-            break;
+    pthread_once(&captureCacheOnce, createCaptureCacheKey);
+    cache = pthread_getspecific(captureCacheKey);
 
-        case 38:
-        case 12:
-            *x = 7;
-            break;
+    if (cache == NULL)
+    {
+        // Every key starts at 0, which no position has as its progress is at least 1
+        cache = calloc(CAPTURE_CACHE_SIZE, sizeof(CaptureEntry));
 
-        case 37:
-        case 36:
-        case 35:
-        case 34:
-        case 33:
-        case 32:
-        case 18:
-        case 17:
-        case 16:
-        case 15:
-        case 14:
-        case 13:
-            *x = 8;
-            break;
+        if (cache == NULL)
+        {
+            endwin();
+            printf("Not enough memory for the capture chances\n");
+            exit(1);
+        }
 
-        case 31:
-        case 19:
-            *x = 9;
-            break;
+        pthread_setspecific(captureCacheKey, cache);
+    }
 
-        case 30:
-        case 20:
-            *x = 10;
-            break;
+    return cache;
+}
 
-        case 29:
-        case 21:
-            *x = 11;
-            break;
+int sixMovesLeft(int relpos)
+{
+    int sixes = relpos <= 51 ? (51 - relpos) / 6 + 1 : 0;
 
-        case 28:
-        case 22:
-            *x = 12;
-            break;
+    return sixes < 2 ? sixes : 2;
+}
 
-        case 27:
-        case 23:
-            *x = 13;
-            break;
+double captureProbability(GameContext *game, Tokens token)
+{
+    int own = whosOpponents(token.col);
+    int behind[4];          // Distance of every token of the colour that can come
+    double notCaptured = 1; // Chance that no colour captures the token
+    double chance;
+    Tokens *other;
+    int numberOfTokens, spare, home;
+    int colour, progress, distance, i;
+
+    if (token.safe || token.pos == 0)
+    {
+        return 0;
+    }
 
-        case 26:
-        case 25:
-        case 24:
-            *x = 14;
-            break;
+    for (colour = 0; colour < 4; colour++)
+    {
+        if (colour == own || game->players[colour].col == 'n')
+        {
+            continue;
         }
 
-        // Search for the collumns
-        switch (token.pos)
+        // Position of the token as relpos of the colour, after 51 its tokens turn into the safezone
+        progress = token.pos - colourGeometry[colour].start + 1;
+        if (progress <= 0)
         {
-        case 39:
-        case 38:
-        case 37:
-            *y = 0;
-            break;
-
-        case 40:
-        case 36:
-            *y = 1;
-            break;
-
-        case 41:
-        case 35:
-            *y = 2;
-            break;
+            progress += 52;
+        }
+        if (progress > 51)
+        {
+            continue;
+        }
 
-        case 42:
-        case 34:
-            *y = 3;
-            break;
+        numberOfTokens = 0;
+        spare = 0;
+        home = 0;
+        for (i = 0; i < 4; i++)
+        {
+            other = &game->tokens[colour][i];
 
-        case 43:
-        case 33:
-            *y = 4;
-            break;
+            // A six can't move a token in the safezone
+            if (other->safe)
+            {
+                continue;
+            }
 
-        case 44:
-        case 32:
-            *y = 5;
-            break;
+            distance = progress - other->relpos;
+            if (other->pos == 0)
+            {
+                home++;
+            }
+            else if (distance >= 1 && distance <= CAPTURE_DISTANCE)
+            {
+                behind[numberOfTokens++] = distance;
+            }
+            else if (spare < 2)
+            {
+                spare += sixMovesLeft(other->relpos);
+            }
+        }
 
-        case 50:
-        case 49:
-        case 48:
-        case 47:
-        case 46:
-        case 45:
-        case 31:
-        case 30:
-        case 29:
-        case 28:
-        case 27:
-        case 26:
-            *y = 6;
-            break;
+        // The tokens in the home base only take sixes if the start is too far from the token
+        if (progress - 1 > CAPTURE_DISTANCE)
+        {
+            spare += home * (1 + sixMovesLeft(1));
+            home = 0;
+        }
+        spare = spare < 2 ? spare : 2;
 
-        case 51:
-        case 25:
-            *y = 7;
-            break;
+        if (numberOfTokens == 0 && home == 0)
+        {
+            continue;
+        }
 
-        case 52:
-        case 1:
-        case 2:
-        case 3:
-        case 4:
-        case 5:
-        case 19:
-        case 20:
-        case 21:
-        case 22:
-        case 23:
-        case 24:
-            *y = 8;
-            break;
+        if (numberOfTokens == 1 && home == 0)
+        {
+            // Only one token can come, its chance is in the table
+            chance = captureChance[spare][behind[0]];
+        }
+        else
+        {
+            chance = cachedCaptureChance(behind, numberOfTokens, spare, home, progress);
+        }
 
-        case 6:
-        case 18:
-            *y = 9;
-            break;
+        notCaptured *= 1 - chance;
+    }
 
-        case 7:
-        case 17:
-            *y = 10;
-            break;
+    return 1 - notCaptured;
+}
 
-        case 8:
-        case 16:
-            *y = 11;
-            break;
+bool isThereOpponentsBehind(GameContext *game, Tokens token, int index)
+{
+    // Check for every position behind the token until 6 blocks behind
+    return ringWindow(opponentsRing(game, token), index - 6, 7) != 0;
+}
 
-        case 9:
-        case 15:
-            *y = 12;
-            break;
+int botMuller(GameContext *game, char posmov[], Tokens temp[], int diceNum)
+{
+    Tokens opponents[4];
+    double loss, maxLoss = 0;
+    int i;
+    int min = -1;
+    int pos = -1;
 
-        case 10:
-        case 14:
-            *y = 13;
-            break;
+    // If possible move is to move forward
+    for (i = 0; i < 4; i++)
+    {
+        if (posmov[i] == 'm')
+        {
+            getOpponents(game, temp[i], opponents, temp[i].pos + diceNum);
 
-        case 11:
-        case 12:
-        case 13:
-            *y = 14;
-            break;
+            // Prioritize the token with the most progress to lose to the opponents behind
+            // it, as long as they're close enough to come in two rolls
+            loss = captureProbability(game, temp[i]) * temp[i].relpos;
+            if (loss > maxLoss && captureProbability(game, temp[i]) >= 1.0 / 36 && opponents[0].col == 'n')
+            {
+                maxLoss = loss;
+                pos = i;
+            }
         }
     }
-}
 
-void printTokens()
-{
-    int tempHome[4]; // Counting how many tokens are in one homebase
-                     // The content are sorted by colour with the
-                     // order of red, green, yellow, and blue
-    int i, j;        // Looping
-    int x, y;        // Temporary storage for the coordinate in the board
-    char tempShown;  // Temporary place for the the shown string
+    if (pos != -1)
+    {
+        return pos;
+    }
 
-    // Initialize the array
     for (i = 0; i < 4; i++)
     {
-        tempHome[i] = 0;
+        // Next priority any is token in the safe, and can move
+        if (temp[i].safe && posmov[i] == 'm')
+        {
+            return i;
+        }
     }
 
-    // Red tokens
+    // Next priority on the token that's still in home base
     for (i = 0; i < 4; i++)
     {
-        // Tokens that are still in homebase
-        if (red[i].pos == 0)
+        // If possible move is to get the token out of the homebase, check if there's no one behind
+        if (posmov[i] == 'o')
         {
-            switch (tempHome[0])
+            switch (game->playerIndex[game->whosTurn - 1] + 1)
             {
-            case 0:
-                mvwprintw(board[2][11], 0, 0, "%c", tokenShown(i));
-                wrefresh(board[2][11]);
-                break;
-
             case 1:
-                mvwprintw(board[2][12], 0, 0, "%c", tokenShown(i));
-                wrefresh(board[2][12]);
+                if (!isThereOpponentsBehind(game, temp[i], 1))
+                {
+                    return i;
+                }
                 break;
 
             case 2:
-                mvwprintw(board[3][11], 0, 0, "%c", tokenShown(i));
-                wrefresh(board[3][11]);
+                if (!isThereOpponentsBehind(game, temp[i], 14))
+                {
+                    return i;
+                }
                 break;
 
             case 3:
-                mvwprintw(board[3][12], 0, 0, "%c", tokenShown(i));
-                wrefresh(board[3][12]);
+                if (!isThereOpponentsBehind(game, temp[i], 27))
+                {
+                    return i;
+                }
+            case 4:
+                if (!isThereOpponentsBehind(game, temp[i], 51))
+                {
+                    return i;
+                }
                 break;
 
             default:
                 break;
             }
-
-            tempHome[0]++;
-        }
-        else
-        {
-            // Get coordinates
-            positionToCoordinate(red[i], &x, &y);
-            // Show the token
-            wprintw(board[x][y], "%c", tokenShown(i));
-            // Show the colour of the token
-            wbkgd(board[x][y], COLOR_PAIR(BOARD_RED));
-            // Refersh the board
-            wrefresh(board[x][y]);
         }
     }
 
-    // Green tokens
+    // If there's still no token with that criteria, move out the token which is farthest from safezone
     for (i = 0; i < 4; i++)
     {
-        // Tokens that are still in homebase
-        if (green[i].pos == 0)
+        if (posmov[i] == 'm')
         {
-            switch (tempHome[1])
+            if (i == 0)
             {
-            case 0:
-                mvwprintw(board[11][11], 0, 0, "%c", tokenShown(i));
-                wrefresh(board[11][11]);
-                break;
-
-            case 1:
-                mvwprintw(board[11][12], 0, 0, "%c", tokenShown(i));
-                wrefresh(board[11][12]);
-                break;
-
-            case 2:
-                mvwprintw(board[12][11], 0, 0, "%c", tokenShown(i));
-                wrefresh(board[12][11]);
-                break;
-
-            case 3:
-                mvwprintw(board[12][12], 0, 0, "%c", tokenShown(i));
-                wrefresh(board[12][12]);
-                break;
-
-            default:
-                break;
+                // Initialize the min with the first token relpos
+                min = temp[i].relpos;
+                pos = i;
+            }
+            else if (min > temp[i].relpos)
+            {
+                min = temp[i].relpos;
+                pos = i;
             }
+        }
+    }
+
+    // Check if there's one found
+    if (min != -1 && pos != -1)
+    {
+        return pos;
+    }
 
-            tempHome[1]++;
-        }
-        else
+    // If there's still no possibilities, move out the first token that's possible to move
+    for (int i = 0; i < 4; i++)
+    {
+        if (posmov[i] == 'm' || posmov[i] == 'o')
         {
-            // Get coordinates
-            positionToCoordinate(green[i], &x, &y);
-            // Show the token
-            wprintw(board[x][y], "%c", tokenShown(i));
-            // Show the colour of the token
-            wbkgd(board[x][y], COLOR_PAIR(BOARD_GREEN));
-            // Refersh the board
-            wrefresh(board[x][y]);
+            return i;
         }
     }
+}
 
-    // Yellow tokens
-    for (i = 0; i < 4; i++)
+int botKlaus(GameContext *game, char posmov[], Tokens temp[], int diceNum, int numberOfSix)
+{
+    Search search;
+    Move moves[4];
+    double value, bestValue;
+    int numberOfMoves;
+    int best;
+    int depthBest;
+    int depth, i;
+
+    // The tokens are read from the game while searching
+    (void)temp;
+
+    // The race in the safezone is already solved
+    best = tablebaseMove(game, posmov, diceNum, numberOfSix);
+    if (best != -1)
     {
-        // Tokens that are still in homebase
-        if (yellow[i].pos == 0)
-        {
-            switch (tempHome[2])
-            {
-            case 0:
-                mvwprintw(board[11][2], 0, 0, "%c", tokenShown(i));
-                wrefresh(board[11][2]);
-                break;
+        return best;
+    }
 
-            case 1:
-                mvwprintw(board[11][3], 0, 0, "%c", tokenShown(i));
-                wrefresh(board[11][3]);
-                break;
+    // Nothing to search if there's only one token that can be moved
+    numberOfMoves = generateMoves(game, diceNum, moves);
+    if (numberOfMoves == 1)
+    {
+        return moves[0].token;
+    }
 
-            case 2:
-                mvwprintw(board[12][2], 0, 0, "%c", tokenShown(i));
-                wrefresh(board[12][2]);
-                break;
+    search.table = getSearchTable();
+    search.root = game->playerIndex[game->whosTurn - 1];
+    search.deadline = searchBudget > 0 ? monotonicMillis() + searchBudget : 0;
+    search.isTimeout = false;
+    search.nodes = 0;
 
-            case 3:
-                mvwprintw(board[12][3], 0, 0, "%c", tokenShown(i));
-                wrefresh(board[12][3]);
-                break;
+    // Search deeper while there's time left, the deepest finished search is used
+    for (depth = 1; depth <= searchDepth; depth++)
+    {
+        depthBest = -1;
+        bestValue = 0;
 
-            default:
-                break;
-            }
+        for (i = 0; i < numberOfMoves; i++)
+        {
+            value = searchMove(game, &search, diceNum, numberOfSix, depth, &moves[i]);
 
-            tempHome[2]++;
+            if (depthBest == -1 || value > bestValue)
+            {
+                depthBest = moves[i].token;
+                bestValue = value;
+            }
         }
-        else
+
+        if (search.isTimeout)
         {
-            // Get coordinates
-            positionToCoordinate(yellow[i], &x, &y);
-            // Show the token
-            wprintw(board[x][y], "%c", tokenShown(i));
-            // Show the colour of the token
-            wbkgd(board[x][y], COLOR_PAIR(BOARD_YELLOW));
-            // Refersh the board
-            wrefresh(board[x][y]);
+            break;
         }
+
+        best = depthBest;
     }
 
-    // Blue tokens
+    // Even the first depth isn't finished, move the first token that can be moved
+    return best == -1 ? moves[0].token : best;
+}
+
+double evaluateColour(GameContext *game, int colour)
+{
+    Tokens *token = getColourTokens(game, colour);
+    double value = 0;
+    int i;
+
     for (i = 0; i < 4; i++)
     {
-        // Tokens that are still in homebase
-        if (blue[i].pos == 0)
+        if (token[i].safe)
         {
-            switch (tempHome[3])
-            {
-            case 0:
-                mvwprintw(board[2][2], 0, 0, "%c", tokenShown(i));
-                wrefresh(board[2][2]);
-                break;
-
-            case 1:
-                mvwprintw(board[2][3], 0, 0, "%c", tokenShown(i));
-                wrefresh(board[2][3]);
-                break;
-
-            case 2:
-                mvwprintw(board[3][2], 0, 0, "%c", tokenShown(i));
-                wrefresh(board[3][2]);
-                break;
-
-            case 3:
-                mvwprintw(board[3][3], 0, 0, "%c", tokenShown(i));
-                wrefresh(board[3][3]);
-                break;
-
-            default:
-                break;
-            }
-
-            tempHome[3]++;
+            // Tokens in the safezone can't be captured, the finished one is worth the most
+            value += token[i].pos == 6 ? 100 : 65 + token[i].pos;
         }
-        else
+        else if (token[i].pos != 0)
         {
-            // Get coordinates
-            positionToCoordinate(blue[i], &x, &y);
-            // Show the token
-            wprintw(board[x][y], "%c", tokenShown(i));
-            // Show the colour of the token
-            wbkgd(board[x][y], COLOR_PAIR(BOARD_BLUE));
-            // Refersh the board
-            wrefresh(board[x][y]);
+            // An opponent that comes to the token has to win the suit to send it home
+            value += (10 + token[i].relpos) * (1 - SUIT_WIN_CHANCE * captureProbability(game, token[i]));
         }
     }
+
+    return value;
 }
 
-char tokenShown(int index)
+double evaluatePosition(GameContext *game, int root)
 {
-    switch (index)
+    double strongest = 0;
+    double value;
+    int colour;
+
+    for (colour = 0; colour < 4; colour++)
     {
-    case 0:
-        return 'A';
-        break;
+        if (colour == root || game->players[colour].col == 'n')
+        {
+            continue;
+        }
 
-    case 1:
-        return 'B';
-        break;
+        value = evaluateColour(game, colour);
+        if (value > strongest)
+        {
+            strongest = value;
+        }
+    }
 
-    case 2:
-        return 'C';
-        break;
+    return evaluateColour(game, root) - strongest;
+}
 
-    case 3:
-        return 'D';
-        break;
+pthread_key_t searchTableKey;
+pthread_once_t searchTableOnce = PTHREAD_ONCE_INIT;
 
-    default:
-        return 'n';
-        break;
-    }
+void createSearchTableKey()
+{
+    // The table is freed when its thread exits
+    pthread_key_create(&searchTableKey, free);
 }
 
-int whosOpponents(char color)
+SearchEntry *getSearchTable()
 {
-    switch (color)
-    {
-    case 'r':
-        return 0;
-        break;
+    SearchEntry *table;
 
-    case 'g':
-        return 1;
-        break;
+    pthread_once(&searchTableOnce, createSearchTableKey);
+    table = pthread_getspecific(searchTableKey);
 
-    case 'y':
-        return 2;
-        break;
+    if (table == NULL)
+    {
+        // Every entry starts empty with depth 0
+        table = calloc(SEARCH_TABLE_SIZE, sizeof(SearchEntry));
 
-    case 'b':
-        return 3;
-        break;
+        if (table == NULL)
+        {
+            endwin();
+            printf("Not enough memory for the search table\n");
+            exit(1);
+        }
 
-    default:
-        break;
+        pthread_setspecific(searchTableKey, table);
     }
+
+    return table;
 }
 
-int tokenCharToInt(char token)
+double searchChance(GameContext *game, Search *search, int sixes, int depth)
 {
-    switch (tolower(token))
-    {
-    case 'a':
-        return 0;
-        break;
-
-    case 'b':
-        return 1;
-        break;
-
-    case 'c':
-        return 2;
-        break;
+    PackedGame packed;
+    SearchEntry *entry;
+    double value = 0;
+    int diceNum;
 
-    case 'd':
-        return 3;
-        break;
+    if (depth == 0 || isItWin(game, search->root))
+    {
+        return evaluatePosition(game, search->root);
+    }
 
-    default:
-        return -1;
-        break;
+    // Check the time every 256 positions, the clock is too slow to be read every time
+    search->nodes++;
+    if (search->deadline != 0 && (search->nodes & 255) == 0 && monotonicMillis() > search->deadline)
+    {
+        search->isTimeout = true;
+    }
+    if (search->isTimeout)
+    {
+        return 0;
     }
-}
 
-bool isAllBotWin()
-{
-    int howManyBotsAreWin;
-    for (int i = 0; i < numberOfBots + 1; i++)
+    packGame(game, &packed);
+    entry = &search->table[positionHash(game, sixes) & (SEARCH_TABLE_SIZE - 1)];
+
+    // A value searched at least as deep can be used as is
+    if (entry->depth >= depth && entry->sixes == sixes && entry->root == search->root &&
+        memcmp(&entry->packed, &packed, sizeof(PackedGame)) == 0)
     {
-        if (players[playerIndex[i]].comp)
-        {
-            if (isItWin(playerIndex[i]))
-            {
-                howManyBotsAreWin++;
-            }
-        }
+        return entry->value;
     }
-    if (howManyBotsAreWin == numberOfBots)
+
+    for (diceNum = 1; diceNum <= 6; diceNum++)
     {
-        return true;
+        value += searchDice(game, search, diceNum, sixes, depth) / 6;
     }
-    else
-        return false;
-}
 
-bool isUserWin()
-{
-    for (int i = 0; i < numberOfBots + 1; i++)
+    // Keep the deeper search if two positions share the entry
+    if (!search->isTimeout && (entry->depth <= depth || memcmp(&entry->packed, &packed, sizeof(PackedGame)) != 0))
     {
-        if (!players[playerIndex[i]].comp)
-        {
-            if (isItWin(playerIndex[i]))
-            {
-                return true;
-            }
-            else
-                return false;
-        }
+        entry->packed = packed;
+        entry->sixes = sixes;
+        entry->root = search->root;
+        entry->depth = depth;
+        entry->value = value;
     }
-}
 
-bool isGameOver()
-{
-    return (isAllBotWin() || isUserWin());
+    return value;
 }
 
-bool isItWin(int index)
+double searchDice(GameContext *game, Search *search, int diceNum, int sixes, int depth)
 {
-    Tokens token[4];
-    int finishedToken = 0;
-    tokensOfPlayer(token, index);
-    for (int i = 0; i < 4; i++)
+    GameContext next;
+    Move moves[4];
+    bool isRoot = game->playerIndex[game->whosTurn - 1] == search->root;
+    double value, bestValue = 0;
+    int numberOfMoves;
+    int i;
+
+    numberOfMoves = generateMoves(game, diceNum, moves);
+
+    for (i = 0; i < numberOfMoves; i++)
     {
-        if ((token[i].pos == 6) && token[i].safe) //the safezone number 6 is finish line
+        value = searchMove(game, search, diceNum, sixes, depth, &moves[i]);
+
+        if (i == 0 || (isRoot ? value > bestValue : value < bestValue))
         {
-            finishedToken++;
+            bestValue = value;
         }
     }
-    if (finishedToken == 4)
+
+    // No tokens can be moved, the turn is over
+    if (numberOfMoves == 0)
     {
-        return true;
+        next = *game;
+        moveToNextTurn(&next);
+        bestValue = searchChance(&next, search, 0, depth - 1);
     }
-    else
-        return false;
+
+    return bestValue;
 }
 
-void tokensOfPlayer(Tokens token[], int index)
+double searchMove(GameContext *game, Search *search, int diceNum, int sixes, int depth, Move *move)
 {
-    //because of function can return array then instead of function, initialize the token can use procedure to initialize the players token to be checked
-    switch (index)
+    GameContext next;
+    double value = 0;
+    double chance = 1; // Chance of the result of the suit
+    int whosWin;
+
+    // The mover wins the suit more often than not, without a capture there's only one result
+    for (whosWin = move->isCapture ? 1 : 0; whosWin <= 2; whosWin++)
     {
-    case 0:
-        for (int i = 0; i < 4; i++)
+        if (whosWin != 0)
         {
-            token[i] = red[i];
+            chance = whosWin == 1 ? SUIT_WIN_CHANCE : 1 - SUIT_WIN_CHANCE;
         }
-        break;
 
-    case 1:
-        for (int i = 0; i < 4; i++)
+        next = *game;
+        playMove(&next, diceNum, move, whosWin);
+
+        // The third six ends the turn like in aTurn
+        if (diceNum == 6 && sixes + 1 < 3)
         {
-            token[i] = green[i];
+            value += chance * searchChance(&next, search, sixes + 1, depth - 1);
         }
-        break;
-
-    case 2:
-        for (int i = 0; i < 4; i++)
+        else
         {
-            token[i] = yellow[i];
+            moveToNextTurn(&next);
+            value += chance * searchChance(&next, search, 0, depth - 1);
         }
-        break;
 
-    case 3:
-        for (int i = 0; i < 4; i++)
+        if (whosWin == 0)
         {
-            token[i] = blue[i];
+            return value;
         }
-        break;
-
-    default:
-        break;
     }
+
+    return value;
 }
 
-void initHighScore()
+int botFranz(GameContext *game, char posmov[], Tokens temp[], int diceNum, int numberOfSix)
 {
-    FILE *yey = fopen("highscore.txt", "wb");
-    Score scr;
+    Playout start;               // The game before the move
+    Playout next;                // Copy of the game for one playout, on the stack so nothing is allocated
+    Random stream;               // Random stream of the playouts
+    long plays[4] = {0, 0, 0, 0}; // Number of playouts of every token
+    long wins[4] = {0, 0, 0, 0};  // Number of playouts of every token won by the bot
+    long long deadline = searchBudget > 0 ? monotonicMillis() + searchBudget : 0;
+    int root = game->playerIndex[game->whosTurn - 1];
+    int rivals;
+    int moves[4];
+    int numberOfMoves = 0;
+    int best;
+    long total;
+    int i;
 
-    strncpy(scr.name, "Belum_ada", 25);
-    scr.score = 0;
+    // The tokens are read from the game in the playouts
+    (void)temp;
 
-    for (int i = 0; i < 10; i++)
+    // The race in the safezone is already solved
+    best = tablebaseMove(game, posmov, diceNum, numberOfSix);
+    if (best != -1)
     {
-        fprintf(yey, "%s %d\n", scr.name, scr.score);
+        return best;
     }
-}
-
-void showHighScore()
-{
-    WINDOW *highScore;
-    FILE *yey = fopen("highscore.txt", "rb");
-    Score scr;
-    char temp[55];
-    
-    clear();
-    refresh();
-
-    highScore = newWindow(15, 57, getMiddleX(stdscr, 57), 5);
-    wrefresh(highScore);
 
-    mvwprintw(highScore, 1, getMiddleX(highScore, strlen("WALL OF FAME")), "WALL OF FAME");
-    mvwprintw(highScore, 2, getMiddleX(highScore, strlen("HIGH SCORE OF DECADE")), "HIGH SCORE OF DECADE");
-    wrefresh(highScore);
+    for (i = 0; i < 4; i++)
+    {
+        if (posmov[i] != 's')
+        {
+            moves[numberOfMoves] = i;
+            numberOfMoves++;
+        }
+    }
 
-    for (int i = 0; i < 10; i++)
+    // Nothing to try if there's only one token that can be moved
+    if (numberOfMoves == 1)
     {
-        fscanf(yey, "%s %d\n", scr.name, &scr.score);
-        mvwprintw(highScore, 3 + i, 3, "%d %s %d\n", (i + 1), scr.name, scr.score);
+        return moves[0];
     }
 
-    fclose(yey);
+    rivals = playoutRivals(game, root);
 
-    wborder(highScore, 0, 0, 0, 0, 0, 0, 0, 0);
+    // Seeded from the game without using its stream, so the dice of the game stay the same
+    seedRandom(&stream, splitSeed(game->rng.state, game->count));
+    initPlayout(game, &start);
 
-    wattron(highScore, A_REVERSE);
-    mvwprintw(highScore, 14, getMiddleX(highScore, strlen("Exit")), "Exit");
-    wattroff(highScore, A_REVERSE);
+    for (total = 0; playoutLimit == 0 || total < playoutLimit; total++)
+    {
+        // The clock is too slow to be checked every playout
+        if (deadline != 0 && (total & 63) == 0 && monotonicMillis() > deadline)
+        {
+            break;
+        }
 
-    wrefresh(highScore);
-    getch();
-}
+        best = selectPlayoutMove(plays, wins, moves, numberOfMoves);
 
-void writeHighScore(int newHighScore, char usrname[])
-{
-    FILE *X;
+        next = start;
+        next.rng.state = nextRandom(&stream);
 
-    X = fopen("highscore.txt", "ab");
-    fprintf(X, "%s %d", usrname, newHighScore);
-    fclose(X);
+        playoutTurn(&next, diceNum, numberOfSix, best);
+        plays[best]++;
+        if (playGameOut(&next, root, rivals))
+        {
+            wins[best]++;
+        }
+    }
 
-    sortHighScore();
+    return bestWinRate(plays, wins, moves, numberOfMoves);
 }
 
-bool isHighScore(int caHighScore)
+int botWerner(GameContext *game, char posmov[], Tokens temp[], int diceNum, int numberOfSix)
 {
-    FILE *X;
-    Score scr;
-
-    X = fopen("highscore.txt", "rb");
-
-    for (int i = 0; i < 10; i++)
-    {
-        fscanf(X, "%s %d\n", scr.name, &scr.score);
+    int best = tablebaseMove(game, posmov, diceNum, numberOfSix);
+    long total;
 
-        if (scr.score < caHighScore)
-        {
-            fclose(X);
-            return true;
-        }
+    // The tokens are read from the game in the playouts
+    (void)temp;
+
+    // The race in the safezone is already solved
+    if (best != -1)
+    {
+        return best;
     }
-    fclose(X);
-    return false;
+
+    return parallelPlayouts(game, posmov, diceNum, numberOfSix, playoutThreads > 0 ? playoutThreads : getNumberOfThreads(),
+                            isRootParallel, playoutLimit, searchBudget, &total);
 }
 
-void sortHighScore()
+int parallelPlayouts(GameContext *game, char posmov[], int diceNum, int numberOfSix, int numberOfThreads,
+                     bool isRootParallel, long limit, int budget, long *total)
 {
-    FILE *arrange;
-    Score scr[12], temp;
-    int N;
+    ParallelPlayout *search;
+    PlayoutWorker workers[MAX_THREAD];
+    pthread_t threads[MAX_THREAD];
+    long plays[4] = {0, 0, 0, 0};
+    long wins[4] = {0, 0, 0, 0};
+    int best;
     int i, j;
 
-    arrange = fopen("highscore.txt", "rb");
-    N = 0;
-    while (!feof(arrange))
+    *total = 0;
+
+    // The shared counters are kept away from the stack of the bot, on their own cache line
+    search = alignedAlloc(sizeof(ParallelPlayout));
+
+    if (search == NULL)
     {
-        fscanf(arrange, "%s %d", scr[N].name, &scr[N].score);
-        N++;
+        endwin();
+        printf("Not enough memory for the playouts\n");
+        exit(1);
     }
 
-    fclose(arrange);
-
-    for (i = 0; i < N - 1; i++)
+    search->numberOfMoves = 0;
+    for (i = 0; i < 4; i++)
     {
-        for (j = 0; j < N - i - 1; j++)
+        if (posmov[i] != 's')
         {
-            if (scr[j].score < scr[j + 1].score)
-            {
-                temp = scr[j];
-                scr[j] = scr[j + 1];
-                scr[j + 1] = temp;
-            }
+            search->moves[search->numberOfMoves] = i;
+            search->numberOfMoves++;
         }
     }
 
-    arrange = fopen("highscore.txt", "wb");
-
-    for (i = 0; i < 10; i++)
+    // Nothing to try if there's only one token that can be moved
+    if (search->numberOfMoves == 1)
     {
-        fprintf(arrange, "%s %d\n", scr[i].name, scr[i].score);
+        best = search->moves[0];
+        alignedFree(search);
+        return best;
     }
 
-    fclose(arrange);
-}
+    initPlayout(game, &search->start);
+    search->diceNum = diceNum;
+    search->numberOfSix = numberOfSix;
+    search->root = game->playerIndex[game->whosTurn - 1];
+    search->rivals = playoutRivals(game, search->root);
+    search->limit = limit;
+    search->deadline = budget > 0 ? monotonicMillis() + budget : 0;
+    search->isRootParallel = isRootParallel;
+
+    // Seeded from the game without using its stream, so the dice of the game stay the same
+    search->seed = splitSeed(game->rng.state, game->count);
+    atomic_init(&search->total, 0);
+    for (i = 0; i < 4; i++)
+    {
+        atomic_init(&search->plays[i], 0);
+        atomic_init(&search->wins[i], 0);
+    }
 
-void aTurn()
-{
-    char posmov[4];      // Storage for possible move
-    int diceRoll = 0;    // Temporary storage for diceroll
-    int numberOfSix = 0; // Count the number of the six in the dice roll
-    int numOfToken;      // Number of token that's going to be moved
-    int i;               // Looping
-    int tempcount = 0;   // Counting the possibilities of stuck
-    Tokens temp[4];      // Temporary token storage for the current player
+    numberOfThreads = numberOfThreads < 1 ? 1 : (numberOfThreads > MAX_THREAD ? MAX_THREAD : numberOfThreads);
 
-    clearOptionBox();
-    switch (playerIndex[whosTurn - 1] + 1)
+    // The calling thread plays as well, as the first worker
+    for (i = 0; i < numberOfThreads; i++)
     {
-    case 1:
-        printToOptionBox("Red Turn", 1, 1);
-        break;
-
-    case 2:
-        printToOptionBox("Green Turn", 1, 1);
-        break;
+        workers[i].search = search;
+        workers[i].id = i;
 
-    case 3:
-        printToOptionBox("Yellow Turn", 1, 1);
-        break;
+        if (i > 0)
+        {
+            pthread_create(&threads[i], NULL, playoutWorker, &workers[i]);
+        }
+    }
+    playoutWorker(&workers[0]);
 
-    case 4:
-        printToOptionBox("Blue Turn", 1, 1);
-        break;
+    for (i = 1; i < numberOfThreads; i++)
+    {
+        pthread_join(threads[i], NULL);
     }
-    WaitForSecond(1);
 
-    // Get the tokens
-    for (int i = 0; i < 4; i++)
+    // Merge the statistic of every thread, or take the shared one
+    for (i = 0; i < 4; i++)
     {
-        temp[i] = getTokens(i);
+        if (isRootParallel)
+        {
+            for (j = 0; j < numberOfThreads; j++)
+            {
+                plays[i] += workers[j].plays[i];
+                wins[i] += workers[j].wins[i];
+            }
+        }
+        else
+        {
+            plays[i] = atomic_load(&search->plays[i]);
+            wins[i] = atomic_load(&search->wins[i]);
+        }
+
+        *total += plays[i];
     }
 
-    if (players[playerIndex[whosTurn - 1]].comp)
+    best = bestWinRate(plays, wins, search->moves, search->numberOfMoves);
+
+    alignedFree(search);
+    return best;
+}
+
+void *playoutWorker(void *arg)
+{
+    PlayoutWorker *worker = arg;
+    ParallelPlayout *search = worker->search;
+    Playout next;                 // Copy of the game for one playout, on the stack so nothing is allocated
+    Random stream;                // Random stream of the playouts of the thread
+    long plays[4] = {0, 0, 0, 0}; // Statistic the move is selected from, the thread's own with root parallel
+    long wins[4] = {0, 0, 0, 0};
+    long count;                   // Playouts of the thread
+    int best;
+    int i;
+
+    seedRandom(&stream, splitSeed(search->seed, worker->id));
+
+    for (count = 0;; count++)
     {
-        diceRoll = RollADice();
-        printw("%d", diceRoll);
-        refresh();
+        // Without a limit the shared count isn't needed, so nothing is written to it
+        if (search->limit != 0 && atomic_fetch_add_explicit(&search->total, 1, memory_order_relaxed) >= search->limit)
+        {
+            break;
+        }
 
-        while (numberOfSix < 3)
+        // The clock is too slow to be checked every playout
+        if (search->deadline != 0 && (count & 63) == 0 && monotonicMillis() > search->deadline)
         {
-            tempcount = 0;
+            break;
+        }
 
-            // Get the tokens
-            for (int i = 0; i < 4; i++)
+        if (search->isRootParallel)
+        {
+            // Counted on the stack, the workers are next to each other so they would share cache lines
+            best = selectPlayoutMove(plays, wins, search->moves, search->numberOfMoves);
+            plays[best]++;
+        }
+        else
+        {
+            for (i = 0; i < 4; i++)
             {
-                temp[i] = getTokens(i);
+                plays[i] = atomic_load_explicit(&search->plays[i], memory_order_relaxed);
+                wins[i] = atomic_load_explicit(&search->wins[i], memory_order_relaxed);
             }
 
-            for (int i = 0; i < 4; i++)
+            // Count the playout before it's played, so the other threads see it as
+            // lost until it's done and try the other moves (virtual loss)
+            best = selectPlayoutMove(plays, wins, search->moves, search->numberOfMoves);
+            atomic_fetch_add_explicit(&search->plays[best], 1, memory_order_relaxed);
+        }
+
+        next = search->start;
+        next.rng.state = nextRandom(&stream);
+
+        playoutTurn(&next, search->diceNum, search->numberOfSix, best);
+        if (playGameOut(&next, search->root, search->rivals))
+        {
+            if (search->isRootParallel)
             {
-                posmov[i] = possibleMove(diceRoll, temp[i].pos, temp[i].safe);
+                wins[best]++;
             }
-
-            for (i = 0; i < 4; i++)
+            else
             {
-                if (posmov[i] == 's')
-                    tempcount++;
+                atomic_fetch_add_explicit(&search->wins[best], 1, memory_order_relaxed);
             }
+        }
+    }
 
-            if (tempcount < 4)
-            {
-                switch (players[playerIndex[whosTurn - 1]].comptype)
-                {
-                case 'j':
-                    numOfToken = botJorgen(posmov, temp);
-                    break;
 
-                case 'h':
-                    numOfToken = botHans(posmov, temp, diceRoll);
-                    break;
+    for (i = 0; i < 4; i++)
+    {
+        worker->plays[i] = search->isRootParallel ? plays[i] : 0;
+        worker->wins[i] = search->isRootParallel ? wins[i] : 0;
+    }
+    return NULL;
+}
 
-                case 'm':
-                    numOfToken = botMuller(posmov, temp, diceRoll);
-                    break;
+int selectPlayoutMove(long plays[4], long wins[4], int moves[], int numberOfMoves)
+{
+    double score, bestScore = 0;
+    long total = 0;
+    int best = -1;
+    int i;
 
-                default:
-                    break;
-                }
+    for (i = 0; i < numberOfMoves; i++)
+    {
+        // Every move is played once first
+        if (plays[moves[i]] == 0)
+        {
+            return moves[i];
+        }
 
-                moveToken(diceRoll, temp[numOfToken], posmov[numOfToken], numOfToken);
+        total += plays[moves[i]];
+    }
 
-                // Clear the board
-                clearBoard();
+    for (i = 0; i < numberOfMoves; i++)
+    {
+        score = (double)wins[moves[i]] / plays[moves[i]] + sqrt(2 * log((double)total) / plays[moves[i]]);
 
-                // Redraw the board
-                showBoard();
+        if (best == -1 || score > bestScore)
+        {
+            best = moves[i];
+            bestScore = score;
+        }
+    }
 
-                // Show the labels
-                showLabel();
+    return best;
+}
 
-                // Redraw the tokens
-                printTokens();
+int bestWinRate(long plays[4], long wins[4], int moves[], int numberOfMoves)
+{
+    double score, bestScore = 0;
+    int best = -1;
+    int i;
 
-                if (diceRoll == 6 && numberOfSix < 3)
-                {
-                    numberOfSix++;
-                    diceRoll = RollADice();
-                    printw("%d", diceRoll);
-                    refresh();
-                }
-                else
-                {
-                    break;
-                }
-            }
-            else
-            {
-                break;
-            }
+    for (i = 0; i < numberOfMoves; i++)
+    {
+        if (plays[moves[i]] == 0)
+        {
+            continue;
+        }
+
+        score = (double)wins[moves[i]] / plays[moves[i]];
+        if (best == -1 || score > bestScore)
+        {
+            best = moves[i];
+            bestScore = score;
         }
     }
-    else
-    {
-        // Human player
-        diceRoll = getDiceRoll();
 
-        while (numberOfSix < 3)
+    return best == -1 ? moves[0] : best;
+}
+
+int playoutRivals(GameContext *game, int root)
+{
+    int rivals = 0;
+    int i;
+
+    // The bot wins if it finishes before every player that's still playing
+    for (i = 0; i < game->numberOfBots + 1; i++)
+    {
+        if (game->playerIndex[i] != root && !isItWin(game, game->playerIndex[i]))
         {
-            tempcount = 0;
+            rivals |= 1 << game->playerIndex[i];
+        }
+    }
 
-            // Get the tokens
-            for (int i = 0; i < 4; i++)
-            {
-                temp[i] = getTokens(i);
-            }
+    return rivals;
+}
 
-            getPossibleMove(posmov, temp, diceRoll);
+long long monotonicMillis()
+{
+// Different clock on windows
+#ifdef _WIN32
+    return (long long)GetTickCount64();
+#else
+    struct timespec now;
 
-            for (i = 0; i < 4; i++)
-            {
-                if (posmov[i] == 's')
-                    tempcount++;
-            }
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (long long)now.tv_sec * 1000 + now.tv_nsec / 1000000;
+#endif
+}
 
-            // If there's no tokens that can be moved no need for input
-            if (tempcount < 4)
-            {
-                // Get number of token that want to be move
-                numOfToken = getNumOfToken(posmov);
+void *alignedAlloc(size_t size)
+{
+// Different allocation on windows
+#ifdef _WIN32
+    return _aligned_malloc(size, CACHE_LINE);
+#else
+    return aligned_alloc(CACHE_LINE, size);
+#endif
+}
 
-                // Move the token
-                moveToken(diceRoll, temp[numOfToken], posmov[numOfToken], numOfToken);
-            }
-            else
-            {
-                printToOptionBox("No possible move, press any key to continue...", 1, 1);
-                getch();
-            }
+void alignedFree(void *memory)
+{
+#ifdef _WIN32
+    _aligned_free(memory);
+#else
+    free(memory);
+#endif
+}
+
+int benchmarkCommand(int argc, char *argv[])
+{
+    char modeName[2][8] = {"shared", "root"};
+    GameContext game;
+    char posmov[4];
+    Tokens temp[4];
+    int botIndexes[4] = {2, 2, 2, 2};
+    int budget = argc > 0 ? atoi(argv[0]) : 1000;
+    int maxThreads = argc > 1 ? atoi(argv[1]) : getNumberOfThreads();
+    int numberOfThreads;
+    int diceNum, numberOfMoves;
+    long total;
+    double rate, single[2];
+    int mode, i;
+
+    if (budget < 1 || maxThreads < 1 || maxThreads > MAX_THREAD)
+    {
+        printf("Usage : ludo --benchmark [milliseconds per run] [most threads]\n");
+        return 1;
+    }
+
+    // Same mid game position on every run, four Müllers after 40 turns
+    initHeadlessPlayerData(&game, botIndexes, 1);
+    for (i = 0; i < 40; i++)
+    {
+        headlessTurn(&game, NULL);
+        moveToNextTurn(&game);
+    }
 
-            // Clear the board
-            clearBoard();
+    // First dice roll with more than one token to choose from
+    for (diceNum = 1; diceNum <= 6; diceNum++)
+    {
+        numberOfMoves = 0;
+        for (i = 0; i < 4; i++)
+        {
+            temp[i] = getTokens(&game, i);
+            posmov[i] = possibleMove(diceNum, temp[i].pos, temp[i].safe);
+            numberOfMoves += posmov[i] != 's';
+        }
 
-            // Redraw the board
-            showBoard();
+        if (numberOfMoves > 1)
+        {
+            break;
+        }
+    }
 
-            // Show the labels
-            showLabel();
+    printf("Playouts of Werner for %d milliseconds, up to %d threads\n\n", budget, maxThreads);
+    printf("%-8s %7s %10s %12s %8s %10s\n", "Mode", "Threads", "Playouts", "Playouts/s", "Speedup", "Efficiency");
 
-            // Redraw the tokens
-            printTokens();
+    for (mode = 0; mode < 2; mode++)
+    {
+        // 1, 2, 4, ... and every hardware thread at the end
+        for (numberOfThreads = 1; numberOfThreads <= maxThreads; numberOfThreads = numberOfThreads * 2 > maxThreads && numberOfThreads != maxThreads ? maxThreads : numberOfThreads * 2)
+        {
+            parallelPlayouts(&game, posmov, diceNum, 0, numberOfThreads, mode == 1, 0, budget, &total);
+            rate = total * 1000.0 / budget;
 
-            if (diceRoll == 6 && numberOfSix < 3)
-            {
-                numberOfSix++;
-                diceRoll = getDiceRoll();
-            }
-            else
+            if (numberOfThreads == 1)
             {
-                break;
+                single[mode] = rate;
             }
+
+            printf("%-8s %7d %10ld %12.0f %7.2fx %9.1f%%\n", modeName[mode], numberOfThreads, total, rate,
+                   rate / single[mode], 100 * rate / single[mode] / numberOfThreads);
         }
     }
+
+    return 0;
 }
 
-int getDiceRoll()
+void initPlayout(GameContext *game, Playout *playout)
 {
-    int roll;
-    // Get clear the option box
-    clearOptionBox();
+    int i, j;
 
-    printToOptionBox("Press any key to roll the dice", 1, 1);
-    curs_set(0);
-    wmove(options, 1, 1);
-    clrtoeol();
-    getch();
+    memset(playout->owner, 0, sizeof(playout->owner));
+    memset(playout->stack, 0, sizeof(playout->stack));
+
+    for (i = 0; i < 4; i++)
+    {
+        for (j = 0; j < 4; j++)
+        {
+            playout->progress[i][j] = tokenProgress(game->tokens[i][j]);
+
+            // Tokens of the colours that are not playing are not on the board
+            if (game->players[i].col != 'n' && progressToPosition(i, playout->progress[i][j]) != 0)
+            {
+                playout->owner[progressToPosition(i, playout->progress[i][j])] = i + 1;
+                playout->stack[progressToPosition(i, playout->progress[i][j])]++;
+            }
+        }
+    }
 
-    roll = RollADice();
-    mvwprintw(options, 1, 1, "You got %d press anything to continue", roll);
-    wrefresh(options);
-    getch();
-    return roll;
+    for (i = 0; i < game->numberOfBots + 1; i++)
+    {
+        playout->playerIndex[i] = game->playerIndex[i];
+    }
+
+    playout->numberOfPlayers = game->numberOfBots + 1;
+    playout->whosTurn = game->whosTurn - 1;
+    playout->rng = game->rng;
 }
 
-void pauseHandler(int signum)
+int progressToPosition(int colour, int progress)
 {
-    WINDOW *pauseScreen; // Pause screen
-    int i, highlight = 0, position;
-
-    // Options for the user
-    char options[4][15] = {"Resume", "Save Game", "Save & Exit", "Exit"};
-    char item[9];
-    char ch;
-
-    // Create new window for the menu
-    pauseScreen = newWindow(10, 30, getMiddleX(stdscr, 30), 12);
-    box(pauseScreen, 0, 0);
+    int pos = colourGeometry[colour].start + progress - 1;
 
-    // Enable keypad mode for key up and down
-    keypad(pauseScreen, true);
+    if (progress == 0 || progress > SAFEZONE_PROGRESS)
+    {
+        return 0;
+    }
 
-    // Make sure what has been entered is not shown
-    noecho();
+    // Come back around the board
+    return pos > 52 ? pos - 52 : pos;
+}
 
-    // Hide the cursor
-    curs_set(0);
+void playoutTurn(Playout *playout, int diceRoll, int numberOfSix, int numOfToken)
+{
+    int colour = playout->playerIndex[playout->whosTurn];
+    uint8_t *progress = playout->progress[colour];
+    int moves[4];      // Tokens that can be moved
+    int numberOfMoves; // Number of tokens that can be moved
+    int target;        // Progress of the token after the move
+    int from, pos;     // Board position before and after the move, 0 if it's not on the board
+    int other;         // Colour index of the opponents on the board position
+    int i;
 
-    // Loop until has been inputed
-    while (1)
+    while (numberOfSix < 3)
     {
-        // Show the options
+        numberOfMoves = 0;
+
+        // Same rules as possibleMove, out of the home base only with six and
+        // not past the finish in the safezone
         for (i = 0; i < 4; i++)
         {
-            position = getMiddleX(pauseScreen, strlen(options[i]));
-
-            // Show the highlighted options with highlights
-            if (i == highlight)
-                wattron(pauseScreen, A_REVERSE);
+            moves[numberOfMoves] = i;
+            numberOfMoves += progress[i] == 0 ? diceRoll == 6 : progress[i] + diceRoll <= FINISHED_PROGRESS;
+        }
 
-            mvwprintw(pauseScreen, i + 1, position, options[i]);
+        // No tokens can be moved, the turn is over
+        if (numberOfMoves == 0)
+        {
+            break;
+        }
 
-            if (i == highlight)
-                wattroff(pauseScreen, A_REVERSE);
+        // A single move doesn't need a random number
+        if (numOfToken == -1)
+        {
+            numOfToken = numberOfMoves == 1 ? moves[0] : moves[randomRange(&playout->rng, numberOfMoves)];
         }
 
-        // Get user input
-        ch = wgetch(pauseScreen);
+        target = progress[numOfToken] == 0 ? 1 : progress[numOfToken] + diceRoll;
+        from = progressToPosition(colour, progress[numOfToken]);
+        pos = progressToPosition(colour, target);
+        other = playout->owner[pos] - 1;
 
-        if (ch == (char)KEY_UP)
+        // Leave the board position
+        if (from != 0)
         {
-            highlight--;
-            highlight = (highlight < 0) ? 3 : highlight;
+            playout->stack[from]--;
+            playout->owner[from] = playout->stack[from] == 0 ? 0 : colour + 1;
         }
-        else if (ch == (char)KEY_DOWN)
+
+        // One random number instead of playing the suit until it's not a draw, with the same chance
+        if (pos != 0 && other != -1 && other != colour && (nextRandom(&playout->rng) >> 11) >= (uint64_t)(SUIT_WIN_CHANCE * (1ULL << 53)))
         {
-            highlight++;
-            highlight = (highlight > 3) ? 0 : highlight;
+            // Lost the suit, the token goes back to the home base
+            progress[numOfToken] = 0;
         }
-        else if (ch == 10) // Somehow the usage of KEY_ENTER doesn't work, so char 10 is used instead
+        else
         {
-            if (highlight == 0)
-            {
-                break;
-            }
-            else if (highlight == 1)
+            if (pos != 0 && other != -1 && other != colour)
             {
-                saveGamestate();
-                break;
+                // Won the suit, every opponent on the board position goes back to the home base
+                for (i = 0; i < 4; i++)
+                {
+                    if (progressToPosition(other, playout->progress[other][i]) == pos)
+                    {
+                        playout->progress[other][i] = 0;
+                    }
+                }
+                playout->stack[pos] = 0;
             }
-            else if (highlight == 2)
-            {
-                saveGamestate();
 
-                endwin();
-                exit(5);
-            }
-            else
+            progress[numOfToken] = target;
+            if (pos != 0)
             {
-                endwin();
-                exit(5);
+                playout->owner[pos] = colour + 1;
+                playout->stack[pos]++;
             }
         }
-    }
-
-    // After user input clear out the border and window as
-    // it is not used anymore
-    werase(pauseScreen);
-    wborder(pauseScreen, ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ');
-    wrefresh(pauseScreen);
-    delwin(pauseScreen);
-}
+        numOfToken = -1;
 
-int botJorgen(char posmov[], Tokens temp[])
-{
-    //moving token out of home base
-    for (int i = 0; i < 4; i++)
-    {
-        if (posmov[i] == 'o')
+        if (diceRoll == 6)
         {
-            return i;
+            numberOfSix++;
+            diceRoll = RollADice(&playout->rng);
+        }
+        else
+        {
+            break;
         }
     }
+}
 
-    //moving the token in safe zone
-
-    int inSafeZone = 0, numOfToken = -1;
+bool playGameOut(Playout *playout, int root, int rivals)
+{
+    uint8_t *progress;
+    double turns; // Expected turns of the bot to finish
+    int turn;
+    int player;
 
-    for (int i = 0; i < 4; i++)
+    for (turn = 0; turn < PLAYOUT_ROUNDS * playout->numberOfPlayers; turn++)
     {
-        if (posmov[i] == 'm')
+        // A player can only finish in its own turn
+        player = playout->playerIndex[playout->whosTurn];
+        progress = playout->progress[player];
+        if (((rivals | 1 << root) & 1 << player) && progress[0] == FINISHED_PROGRESS &&
+            progress[1] == FINISHED_PROGRESS && progress[2] == FINISHED_PROGRESS && progress[3] == FINISHED_PROGRESS)
         {
-            if (temp[i].safe)
-            {
-                if (inSafeZone < temp[i].pos)
-                {
-                    inSafeZone = temp[i].pos;
-                    numOfToken = i;
-                }
-            }
+            return player == root;
         }
-    }
 
-    if (numOfToken != -1)
-    {
-        return numOfToken;
+        playout->whosTurn = playout->whosTurn + 1 == playout->numberOfPlayers ? 0 : playout->whosTurn + 1;
+        playoutTurn(playout, RollADice(&playout->rng), 0, -1);
     }
 
-    //moving the biggest relpos
-    int relPos = 0;
 
-    for (int i = 0; i < 4; i++)
+    // The rest of the game is played as a race, most of a random game is spent
+    // on the last tokens so cutting it off keeps the playouts short
+    turns = playoutRaceTurns(playout, root);
+
+    for (player = 0; player < 4; player++)
     {
-        if (posmov[i] == 'm')
+        if ((rivals & 1 << player) && playoutRaceTurns(playout, player) < turns)
         {
-            if (relPos < temp[i].relpos)
-            {
-                relPos = temp[i].relpos;
-                numOfToken = i;
-            }
+            return false;
         }
     }
 
-    return numOfToken;
+    return true;
 }
 
-void saveGamestate()
+double playoutRaceTurns(Playout *playout, int colour)
 {
-    /*
-        Save all the game data present at the current call of the function
-        
-        The game state will be saved at currentState.savegame
-
-        The file structure will be like this :
-        no  content
-        1   Player data
-        2   Player index
-        3   Red Token
-        4   Green Token
-        5   Yelow Token
-        6   Blue Token
-        7   whosTurn
-        8   count
-        9   numberOfBots
-        10  position
-    */
-    FILE *saveGame; // File for saving gamestate
-    int i;          // Looping
-
-    // Open the file, rewrites anything in there
-    saveGame = fopen("currentState.savegame", "wb");
+    uint8_t *progress = playout->progress[colour];
+    int slot[4];
+    int left = 0; // Progress left to finish
+    int i;
 
-    if (saveGame)
+    if (tablebaseTurns != NULL)
     {
-        // Save the player data
-        fwrite(players, sizeof(Player), 4, saveGame);
-
-        // Save the player index data
-        fwrite(playerIndex, sizeof(int), 4, saveGame);
-
-        // Save the red token data
-        fwrite(red, sizeof(Tokens), 4, saveGame);
-
-        // Save the green token data
-        fwrite(green, sizeof(Tokens), 4, saveGame);
-
-        // Save the blue token data
-        fwrite(blue, sizeof(Tokens), 4, saveGame);
-
-        // Save the yellow token data
-        fwrite(yellow, sizeof(Tokens), 4, saveGame);
+        return tablebaseTurns[tablebaseIndex(progress, slot)];
+    }
 
-        // Save the current turn
-        fwrite(&whosTurn, sizeof(int), 1, saveGame);
+    for (i = 0; i < 4; i++)
+    {
+        left += progress[i] == 0 ? FINISHED_PROGRESS + PLAYOUT_HOME_PROGRESS : FINISHED_PROGRESS - progress[i];
+    }
 
-        // Save the count as it's crucial part of the playgame
-        fwrite(&count, sizeof(int), 1, saveGame);
+    // A dice roll is 3.5 on average
+    return left / 3.5;
+}
 
-        // Save the numberOfBots
-        fwrite(&numberOfBots, sizeof(int), 1, saveGame);
+int tablebaseIndex(uint8_t progress[4], int slot[4])
+{
+    uint8_t sorted[4];
+    int i, j, y;
+    int index = 0;
 
-        // Save the position of the player
-        fwrite(&position, sizeof(int), 1, saveGame);
-    }
-    else
+    // Insertion sort of the four tokens, keeping where every token came from
+    for (i = 0; i < 4; i++)
     {
-        clear();
-        printw("Save file cannot be openned, press anything to exit...");
-        getch();
-        exit(6);
+        for (j = i; j > 0 && sorted[j - 1] > progress[i]; j--)
+        {
+            sorted[j] = sorted[j - 1];
+            slot[j] = slot[j - 1];
+        }
+        sorted[j] = progress[i];
+        slot[j] = i;
     }
 
-    // Close
-    fclose(saveGame);
+    // Combinatorial number system, sorted[i] + i is strictly increasing so
+    // every sorted progress has its own index from 0 to TABLEBASE_ENTRIES - 1
+    y = sorted[0];
+    index += y;
+    y = sorted[1] + 1;
+    index += y * (y - 1) / 2;
+    y = sorted[2] + 2;
+    index += y * (y - 1) * (y - 2) / 6;
+    y = sorted[3] + 3;
+    index += y * (y - 1) * (y - 2) * (y - 3) / 24;
+
+    return index;
 }
 
-void getGameState()
+int tablebaseSituation(int diceNum, int numberOfSix)
 {
-    FILE *saveGame; // File for saving gamestate
-    int i;          // Looping
-
-    // Open the file, read it as a binary file
-    saveGame = fopen("currentState.savegame", "rb");
+    return diceNum < 6 ? diceNum - 1 : 5 + numberOfSix;
+}
 
-    if (saveGame)
+int tablebaseCommand(int argc, char *argv[])
+{
+    TablebaseHeader header = {"LUDOTB1", TABLEBASE_ENTRIES, 0};
+    char *fileName = argc > 0 ? argv[0] : TABLEBASE_FILE;
+    double *turns;        // Expected turns from the start of a turn
+    double *afterSix[3];  // Expected turns after the current turn, before rolling again after 1 or 2 sixes
+    float *turnsOut;      // Expected turns as written to the file
+    uint16_t *moves;      // Best moves as written to the file
+    uint8_t progress[4], next[4];
+    int slot[4];
+    double value, best, sum[3];
+    int stuck;
+    int bestSlot;
+    int index, nextIndex;
+    int diceNum, numberOfSix;
+    int a, b, c, d, i;
+    FILE *file;
+
+    turns = malloc(TABLEBASE_ENTRIES * sizeof(double));
+    afterSix[1] = malloc(TABLEBASE_ENTRIES * sizeof(double));
+    afterSix[2] = malloc(TABLEBASE_ENTRIES * sizeof(double));
+    turnsOut = malloc(TABLEBASE_ENTRIES * sizeof(float));
+    moves = calloc(TABLEBASE_ENTRIES, sizeof(uint16_t));
+
+    if (turns == NULL || afterSix[1] == NULL || afterSix[2] == NULL || turnsOut == NULL || moves == NULL)
     {
-        // Get the player data
-        fread(players, sizeof(Player), 4, saveGame);
-
-        // Get the player index data
-        fread(playerIndex, sizeof(int), 4, saveGame);
-
-        // Get the red token data
-        fread(red, sizeof(Tokens), 4, saveGame);
+        printf("Not enough memory for the tablebase\n");
+        return 1;
+    }
 
-        // Get the green token data
-        fread(green, sizeof(Tokens), 4, saveGame);
+    // Every move only adds progress, so the positions are solved from the most
+    // progress down and every position after a move is already solved
+    for (d = FINISHED_PROGRESS; d >= 0; d--)
+        for (c = d; c >= 0; c--)
+            for (b = c; b >= 0; b--)
+                for (a = b; a >= 0; a--)
+                {
+                    progress[0] = a;
+                    progress[1] = b;
+                    progress[2] = c;
+                    progress[3] = d;
+                    index = tablebaseIndex(progress, slot);
 
-        // Get the blue token data
-        fread(blue, sizeof(Tokens), 4, saveGame);
+                    if (a == FINISHED_PROGRESS)
+                    {
+                        turns[index] = afterSix[1][index] = afterSix[2][index] = 0;
+                        turnsOut[index] = 0;
+                        continue;
+                    }
 
-        // Get the yellow token data
-        fread(yellow, sizeof(Tokens), 4, saveGame);
+                    stuck = 0;
+                    sum[0] = sum[1] = sum[2] = 0;
 
-        // Get the current turn
-        fread(&whosTurn, sizeof(int), 1, saveGame);
+                    for (diceNum = 1; diceNum <= 6; diceNum++)
+                    {
+                        // Only a six is different after the sixes before it
+                        for (numberOfSix = 0; numberOfSix < (diceNum == 6 ? 3 : 1); numberOfSix++)
+                        {
+                            bestSlot = -1;
+                            best = 0;
+
+                            for (i = 0; i < 4; i++)
+                            {
+                                // Same rules as possibleMove, tokens with the same progress are the same move
+                                if ((i > 0 && progress[i] == progress[i - 1]) ||
+                                    (progress[i] == 0 ? diceNum != 6 : progress[i] + diceNum > FINISHED_PROGRESS))
+                                {
+                                    continue;
+                                }
+
+                                memcpy(next, progress, 4);
+                                next[i] = progress[i] == 0 ? 1 : progress[i] + diceNum;
+                                nextIndex = tablebaseIndex(next, slot);
+
+                                // Finished, rolls again after a six, or the turn is over
+                                if (next[0] == FINISHED_PROGRESS && next[1] == FINISHED_PROGRESS &&
+                                    next[2] == FINISHED_PROGRESS && next[3] == FINISHED_PROGRESS)
+                                {
+                                    value = 0;
+                                }
+                                else if (diceNum == 6 && numberOfSix + 1 < 3)
+                                {
+                                    value = afterSix[numberOfSix + 1][nextIndex];
+                                }
+                                else
+                                {
+                                    value = turns[nextIndex];
+                                }
+
+                                if (bestSlot == -1 || value < best)
+                                {
+                                    bestSlot = i;
+                                    best = value;
+                                }
+                            }
+
+                            if (bestSlot == -1)
+                            {
+                                // The same for every number of sixes, so it's only counted once
+                                stuck++;
+                                break;
+                            }
+
+                            if (diceNum < 6)
+                            {
+                                sum[0] += best;
+                                sum[1] += best;
+                                sum[2] += best;
+                            }
+                            else
+                            {
+                                sum[numberOfSix] += best;
+                            }
+
+                            moves[index] |= bestSlot << (2 * tablebaseSituation(diceNum, numberOfSix));
+                        }
+                    }
 
-        // Get the count as it's crucial part of the playgame
-        fread(&count, sizeof(int), 1, saveGame);
+                    // A roll without a move ends the turn in the same position, so
+                    // turns = 1 + (sum[0] + stuck * turns) / 6
+                    turns[index] = (1 + sum[0] / 6) / (1 - stuck / 6.0);
+                    afterSix[1][index] = (sum[1] + stuck * turns[index]) / 6;
+                    afterSix[2][index] = (sum[2] + stuck * turns[index]) / 6;
+                    turnsOut[index] = turns[index];
+                }
 
-        // Get the numberOfBots
-        fread(&numberOfBots, sizeof(int), 1, saveGame);
+    file = fopen(fileName, "wb");
 
-        // Get the position of the player
-        fread(&position, sizeof(int), 1, saveGame);
-    }
-    else
+    if (file == NULL)
     {
-        clear();
-        printw("Save file cannot be openned, press anything to exit...");
-        getch();
-        exit(6);
+        printf("Can't write %s\n", fileName);
+        return 1;
     }
 
-    // Close
-    fclose(saveGame);
-}
-
-int botHans(char posmov[], Tokens temp[], int diceNum)
-{
-    //moving the token that near opponents
-    for (int i = 0; i < 4; i++)
-    {
-        if (posmov[i] == 'o')
-        {
-            switch (playerIndex[whosTurn - 1] + 1)
-            {
-            case 1:
-                if (isBotHasOpponents(temp[i], 1))
-                {
-                    return i;
-                }
-                break;
+    fwrite(&header, sizeof(TablebaseHeader), 1, file);
+    fwrite(turnsOut, sizeof(float), TABLEBASE_ENTRIES, file);
+    fwrite(moves, sizeof(uint16_t), TABLEBASE_ENTRIES, file);
+    fclose(file);
 
-            case 2:
-                if (isBotHasOpponents(temp[i], 14))
-                {
-                    return i;
-                }
-                break;
+    progress[0] = progress[1] = progress[2] = progress[3] = 0;
+    printf("Tablebase of %d positions is written to %s\n", TABLEBASE_ENTRIES, fileName);
+    printf("Expected turns from the start : %.2f\n", turns[tablebaseIndex(progress, slot)]);
 
-            case 3:
-                if (isBotHasOpponents(temp[i], 27))
-                {
-                    return i;
-                }
-            case 4:
-                if (isBotHasOpponents(temp[i], 51))
-                {
-                    return i;
-                }
-                break;
+    free(turns);
+    free(afterSix[1]);
+    free(afterSix[2]);
+    free(turnsOut);
+    free(moves);
+    return 0;
+}
 
-            default:
-                break;
-            }
-        }
+bool loadTablebase(char fileName[])
+{
+    size_t size = sizeof(TablebaseHeader) + TABLEBASE_ENTRIES * (sizeof(float) + sizeof(uint16_t));
+    const TablebaseHeader *header;
+    char *data;
 
-        else if (posmov[i] == 'm')
-        {
-            if (isBotHasOpponents(temp[i], temp[i].pos + diceNum))
-            {
-                return i;
-            }
-        }
+// No mmap on windows, the file is read instead
+#ifdef _WIN32
+    FILE *file = fopen(fileName, "rb");
+
+    if (file == NULL)
+    {
+        return false;
     }
 
-    //moving token that can out from base
-    for (int i = 0; i < 4; i++)
+    data = malloc(size);
+    if (data == NULL || fread(data, 1, size, file) != size)
     {
-        if (posmov[i] == 'o')
+        // A file of another size is from another version of the tablebase
+        if (data != NULL)
         {
-            return i;
+            printf("%s is out of date and is not used, rebuild it with --tablebase\n", fileName);
         }
+        free(data);
+        fclose(file);
+        return false;
     }
+    fclose(file);
+#else
+    struct stat info;
+    int file = open(fileName, O_RDONLY);
 
-    //moving the token in safe zone
+    if (file == -1)
+    {
+        return false;
+    }
 
-    int inSafeZone = 0, numOfToken = -1;
+    if (fstat(file, &info) != 0)
+    {
+        close(file);
+        return false;
+    }
 
-    for (int i = 0; i < 4; i++)
+    // A file of another size is from another version of the tablebase
+    if ((size_t)info.st_size != size)
     {
-        if (posmov[i] == 'm')
-        {
-            if (temp[i].safe)
-            {
-                if (inSafeZone < temp[i].pos)
-                {
-                    inSafeZone = temp[i].pos;
-                    numOfToken = i;
-                }
-            }
-        }
+        printf("%s is out of date and is not used, rebuild it with --tablebase\n", fileName);
+        close(file);
+        return false;
     }
 
-    if (numOfToken != -1)
+    // Only the pages that are probed are read from the disk
+    data = mmap(NULL, size, PROT_READ, MAP_SHARED, file, 0);
+    close(file);
+
+    if (data == MAP_FAILED)
     {
-        return numOfToken;
+        return false;
     }
+#endif
 
-    //moving the biggest relpos
-    int relPos = 0;
-    for (int i = 0; i < 4; i++)
+    header = (const TablebaseHeader *)data;
+    if (memcmp(header->magic, "LUDOTB1", 8) != 0 || header->entries != TABLEBASE_ENTRIES)
     {
-        if (posmov[i] == 'm')
-        {
-            if (relPos < temp[i].relpos)
-            {
-                relPos = temp[i].relpos;
-                numOfToken = i;
-            }
-        }
+        printf("%s is out of date and is not used, rebuild it with --tablebase\n", fileName);
+
+// Same as it was loaded
+#ifdef _WIN32
+        free(data);
+#else
+        munmap(data, size);
+#endif
+        return false;
     }
 
-    return numOfToken;
+    tablebaseTurns = (const float *)(data + sizeof(TablebaseHeader));
+    tablebaseMoves = (const uint16_t *)(data + sizeof(TablebaseHeader) + TABLEBASE_ENTRIES * sizeof(float));
+    return true;
 }
 
-bool isBotHasOpponents(Tokens token, int index)
+int tablebaseMove(GameContext *game, char posmov[], int diceNum, int numberOfSix)
 {
-    int i = 0, j = 0;
+    int colour = game->playerIndex[game->whosTurn - 1];
+    uint8_t progress[4];
+    int slot[4];
+    int index, numOfToken;
+    int i;
+
+    if (tablebaseMoves == NULL)
+    {
+        return -1;
+    }
 
-    // Loops every array of token colour
+    // Only exact if no token can be captured anymore
     for (i = 0; i < 4; i++)
     {
-        // Oppponents is there only if they're not the same colour, have the same positions
-        // and not in the safezone
-        for (j = 0; j < 6; j++)
+        if (!game->tokens[colour][i].safe)
         {
-            int numOfBox = index + j;
+            return -1;
+        }
+        progress[i] = tokenProgress(game->tokens[colour][i]);
+    }
 
-            if (numOfBox > 52)
-            {
-                numOfBox -= 52;
-            }
+    index = tablebaseIndex(progress, slot);
+    numOfToken = slot[(tablebaseMoves[index] >> (2 * tablebaseSituation(diceNum, numberOfSix))) & 3];
 
-            if (red[i].col != token.col && red[i].pos == numOfBox && !red[i].safe)
-            {
-                return true;
-            }
-            else if (green[i].col != token.col && green[i].pos == numOfBox && !green[i].safe)
-            {
-                return true;
-            }
-            else if (blue[i].col != token.col && blue[i].pos == numOfBox && !blue[i].safe)
-            {
-                return true;
-            }
-            else if (yellow[i].col != token.col && yellow[i].pos == numOfBox && !yellow[i].safe)
-            {
-                return true;
-            }
-        }
+    return posmov[numOfToken] == 's' ? -1 : numOfToken;
+}
+
+void batchStartGame(BatchGames *batch, int lane, uint64_t seed)
+{
+    int colour, i;
+
+    for (i = 0; i < 16; i++)
+    {
+        batch->progress[i][lane] = 0;
+    }
+    for (colour = 0; colour < 4; colour++)
+    {
+        batch->place[colour][lane] = 0;
     }
 
-    // If there's no opponent
-    return false;
+    // xorshift32 can't start from zero
+    batch->rng[lane] = (uint32_t)seed | 1;
+    batch->finished[lane] = 0;
+    batch->nextPlace[lane] = 1;
+    batch->isPlaying[lane] = 1;
+    batch->turns[lane] = 0;
 }
 
-void showLabel()
+void batchStep(BatchGames *batch, int colour, int numberOfPlayers)
 {
-    int i;
-    char label[15];
-    for (i = 0; i < 4; i++)
+    uint8_t *other;                    // Progress of one token of an opponent
+    // Kept on the stack so the compiler knows they don't overlap the tokens
+    uint8_t choice[BATCH_LANES];       // Token chosen by the policy, 4 if no token is moved
+    uint8_t target[BATCH_LANES];       // Progress of the chosen token after the move
+    uint8_t destination[BATCH_LANES];  // Board position after the move, 0 if it's not on the board
+    uint8_t isHit[BATCH_LANES];        // 0xFF if there's opponents on the destination
+    uint8_t isWon[BATCH_LANES];        // 0xFF if the mover wins the suit
+    uint8_t start = colourGeometry[colour].start - 1;
+    uint8_t otherStart;
+    uint32_t x;
+    uint8_t diceNum, isSix, p, p0, p1, p2, p3, pos, key, bestKey, token, mask;
+    int lane, opponent, t;
+
+    // Every condition is turned into a mask of 0 or 0xFF and every choice is
+    // made with and / or, so no lane ever branches and every loop below is
+    // compiled into SIMD instructions
+
+    // Roll and choose the token like botJorgen : out of the home base first,
+    // then the furthest token in the safezone, then the furthest on the board.
+    // Every rule gets its own range of keys and the largest key is moved
+    for (lane = 0; lane < BATCH_LANES; lane++)
+    {
+        x = batch->rng[lane];
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        diceNum = (uint8_t)((((x >> 16) * 6) >> 16) + 1);
+        isSix = -(uint8_t)(diceNum == 6);
+
+        p0 = batch->progress[colour * 4][lane];
+        p1 = batch->progress[colour * 4 + 1][lane];
+        p2 = batch->progress[colour * 4 + 2][lane];
+        p3 = batch->progress[colour * 4 + 3][lane];
+
+        // Board 1 to 51, safezone 152 to 156, home base 252 to 255 so the
+        // first token leaves first, 0 if the token can't move
+        key = p0 + (100 & -(uint8_t)(p0 > SAFEZONE_PROGRESS));
+        key &= -(uint8_t)(p0 + diceNum <= FINISHED_PROGRESS);
+        key |= 255 & isSix & -(uint8_t)(p0 == 0);
+        token = 0;
+        bestKey = key;
+
+        // Strictly larger, so the first token wins a tie as in botJorgen
+        key = p1 + (100 & -(uint8_t)(p1 > SAFEZONE_PROGRESS));
+        key &= -(uint8_t)(p1 + diceNum <= FINISHED_PROGRESS);
+        key |= 254 & isSix & -(uint8_t)(p1 == 0);
+        mask = -(uint8_t)(key > bestKey);
+        token = (1 & mask) | (token & ~mask);
+        bestKey = (key & mask) | (bestKey & ~mask);
+
+        key = p2 + (100 & -(uint8_t)(p2 > SAFEZONE_PROGRESS));
+        key &= -(uint8_t)(p2 + diceNum <= FINISHED_PROGRESS);
+        key |= 253 & isSix & -(uint8_t)(p2 == 0);
+        mask = -(uint8_t)(key > bestKey);
+        token = (2 & mask) | (token & ~mask);
+        bestKey = (key & mask) | (bestKey & ~mask);
+
+        key = p3 + (100 & -(uint8_t)(p3 > SAFEZONE_PROGRESS));
+        key &= -(uint8_t)(p3 + diceNum <= FINISHED_PROGRESS);
+        key |= 252 & isSix & -(uint8_t)(p3 == 0);
+        mask = -(uint8_t)(key > bestKey);
+        token = (3 & mask) | (token & ~mask);
+        bestKey = (key & mask) | (bestKey & ~mask);
+
+        // The mask is now set if a token is moved
+        mask = -(uint8_t)((bestKey != 0) & batch->isRolling[lane]);
+        token = (token & mask) | (4 & ~mask);
+
+        p = (p0 & -(uint8_t)(token == 0)) | (p1 & -(uint8_t)(token == 1)) |
+            (p2 & -(uint8_t)(token == 2)) | (p3 & -(uint8_t)(token == 3));
+        // Out of the home base to the start, else forward by the dice
+        p = p + diceNum - ((diceNum - 1) & -(uint8_t)(p == 0));
+        pos = p + start;
+        pos -= 52 & -(uint8_t)(pos > 52);
+
+        choice[lane] = token;
+        target[lane] = p;
+        destination[lane] = pos & mask & -(uint8_t)(p <= SAFEZONE_PROGRESS);
+        isHit[lane] = 0;
+        // The suit gets its own number like suitRandom, so it doesn't follow the dice.
+        // The mover wins SUIT_WIN_CHANCE of the suits, the limit is a constant so it stays vectorized
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        batch->rng[lane] = x;
+        isWon[lane] = -(uint8_t)((x >> 16) <= (uint32_t)(SUIT_WIN_CHANCE * 65536));
+        batch->isRolling[lane] = mask & isSix & 1;
+    }
+
+    // Find the opponents on the destination
+    for (opponent = 0; opponent < numberOfPlayers; opponent++)
     {
-        if (players[i].col == 'n')
+        if (opponent == colour)
         {
             continue;
         }
-        else
+
+        otherStart = colourGeometry[opponent].start - 1;
+        for (t = 0; t < 4; t++)
         {
-            if (!players[i].comp)
+            other = batch->progress[opponent * 4 + t];
+            for (lane = 0; lane < BATCH_LANES; lane++)
             {
-                strcpy(label, "You");
+                p = other[lane];
+                pos = p + otherStart;
+                pos -= 52 & -(uint8_t)(pos > 52);
+                isHit[lane] |= -(uint8_t)(((uint8_t)(p - 1) < SAFEZONE_PROGRESS) & (pos == destination[lane]));
             }
-            else
-            {
-                switch (players[i].comptype)
-                {
-                case 'j':
-                    strcpy(label, "Jorgen");
-                    break;
+        }
+    }
 
-                case 'h':
-                    strcpy(label, "Hans");
-                    break;
+    // Move the token, or send it back to the home base if it lost the suit
+    for (lane = 0; lane < BATCH_LANES; lane++)
+    {
+        token = choice[lane];
+        p = target[lane] & ~(isHit[lane] & ~isWon[lane]);
+
+        mask = -(uint8_t)(token == 0);
+        batch->progress[colour * 4][lane] = (p & mask) | (batch->progress[colour * 4][lane] & ~mask);
+        mask = -(uint8_t)(token == 1);
+        batch->progress[colour * 4 + 1][lane] = (p & mask) | (batch->progress[colour * 4 + 1][lane] & ~mask);
+        mask = -(uint8_t)(token == 2);
+        batch->progress[colour * 4 + 2][lane] = (p & mask) | (batch->progress[colour * 4 + 2][lane] & ~mask);
+        mask = -(uint8_t)(token == 3);
+        batch->progress[colour * 4 + 3][lane] = (p & mask) | (batch->progress[colour * 4 + 3][lane] & ~mask);
+
+        // Only a won suit captures, a lost suit leaves the opponents alone
+        destination[lane] &= isHit[lane] & isWon[lane];
+    }
 
-                case 'm':
-                    strcpy(label, "Muller");
-                    break;
-                }
-            }
+    // Send the captured opponents back to their home base
+    for (opponent = 0; opponent < numberOfPlayers; opponent++)
+    {
+        if (opponent == colour)
+        {
+            continue;
+        }
 
-            switch (players[i].col)
+        otherStart = colourGeometry[opponent].start - 1;
+        for (t = 0; t < 4; t++)
+        {
+            other = batch->progress[opponent * 4 + t];
+            for (lane = 0; lane < BATCH_LANES; lane++)
             {
-            case 'r':
-                mvwprintw(board[0][10], 1, 0, label);
-                wrefresh(board[0][10]);
-                break;
+                p = other[lane];
+                pos = p + otherStart;
+                pos -= 52 & -(uint8_t)(pos > 52);
+                other[lane] = p & ~-(uint8_t)(((uint8_t)(p - 1) < SAFEZONE_PROGRESS) & (pos == destination[lane]));
+            }
+        }
+    }
+}
 
-            case 'g':
-                mvwprintw(board[9][10], 1, 0, label);
-                wrefresh(board[9][10]);
-                break;
+void batchTurn(BatchGames *batch, int colour, int numberOfPlayers)
+{
+    uint8_t bit = 1 << colour;
+    uint8_t isDone;
+    int lane, step;
 
-            case 'y':
-                mvwprintw(board[9][1], 1, 0, label);
-                wrefresh(board[9][1]);
-                break;
+    for (lane = 0; lane < BATCH_LANES; lane++)
+    {
+        batch->isRolling[lane] = batch->isPlaying[lane] & ((batch->finished[lane] & bit) == 0);
+    }
 
-            case 'b':
-                mvwprintw(board[0][1], 1, 0, label);
-                wrefresh(board[0][1]);
-                break;
+    // The third six ends the turn like in aTurn
+    for (step = 0; step < 3; step++)
+    {
+        batchStep(batch, colour, numberOfPlayers);
+    }
 
-            default:
-                break;
-            }
-        }
+    // Rank the colour if it has just finished
+    for (lane = 0; lane < BATCH_LANES; lane++)
+    {
+        isDone = batch->isPlaying[lane] & ((batch->finished[lane] & bit) == 0) &
+                 (batch->progress[colour * 4][lane] == FINISHED_PROGRESS) &
+                 (batch->progress[colour * 4 + 1][lane] == FINISHED_PROGRESS) &
+                 (batch->progress[colour * 4 + 2][lane] == FINISHED_PROGRESS) &
+                 (batch->progress[colour * 4 + 3][lane] == FINISHED_PROGRESS);
+
+        batch->place[colour][lane] |= batch->nextPlace[lane] & -isDone;
+        batch->nextPlace[lane] += isDone;
+        batch->finished[lane] |= bit & -isDone;
     }
 }
 
-bool isThereOpponentsBehind(Tokens token, int index)
+int batchCommand(int argc, char *argv[])
 {
-    int i, j; // Looping
-    int pos;  // Position currently being searched
+    BatchGames *batch;
+    GameContext game;
+    long games = argc > 0 ? atol(argv[0]) : 0;
+    int numberOfPlayers = argc > 1 ? atoi(argv[1]) : 4;
+    uint64_t seed = argc > 2 ? strtoull(argv[2], NULL, 10) : (uint64_t)time(NULL);
+    long scalarGames = games < 20000 ? games : 20000;
+    long wins[2][4] = {{0}};   // First places of every seat, scalar then batch
+    long played[2] = {0, 0};   // Games finished by every engine
+    double seconds[2];         // Time taken by every engine
+    long long begin;
+    long started = 0;
+    int botIndexes[4];
+    int rank[4];
+    int unfinished;
+    bool isPlaying;
+    int lane, colour;
+    long i;
+
+    if (games < 1 || numberOfPlayers < 2 || numberOfPlayers > 4)
+    {
+        printf("Usage : ludo --batch <number of games> [players 2-4] [seed]\n");
+        return 1;
+    }
 
-    // Check for every position behind the token until 6 blocks behind
-    for (i = 0; i <= 6; i++)
+    // Scalar headless games of Jörgen, the same as a tournament
+    for (colour = 0; colour < 4; colour++)
     {
-        pos = index - i;
+        botIndexes[colour] = colour < numberOfPlayers ? 0 : -1;
+    }
 
-        // If the position is zero or negative come back to 52
-        if (pos <= 0)
-        {
-            pos += 52;
-        }
+    begin = monotonicMillis();
+    for (i = 0; i < scalarGames; i++)
+    {
+        initHeadlessPlayerData(&game, botIndexes, splitSeed(seed, i));
+        playHeadlessGame(&game, rank, NULL);
 
-        // Check for every position of tokens
-        for (j = 0; j < 4; j++)
+        for (colour = 0; colour < numberOfPlayers; colour++)
         {
-            // Check if there's any opponents tokens in the position and are not in the safezone
-            if (red[i].col != token.col && red[i].pos == pos && !red[i].safe)
-            {
-                return true;
-            }
-            else if (green[i].col != token.col && green[i].pos == pos && !green[i].safe)
-            {
-                return true;
-            }
-            else if (blue[i].col != token.col && blue[i].pos == pos && !blue[i].safe)
-            {
-                return true;
-            }
-            else if (yellow[i].col != token.col && yellow[i].pos == pos && !yellow[i].safe)
-            {
-                return true;
-            }
+            wins[0][colour] += rank[colour] == 1;
         }
+        played[0]++;
     }
+    seconds[0] = (monotonicMillis() - begin) / 1000.0;
 
-    return false;
-}
+    // The lanes are too big to be put on the stack
+    batch = malloc(sizeof(BatchGames));
 
-int botMuller(char posmov[], Tokens temp[], int diceNum)
-{
-    Tokens opponents[4];
-    int i;
-    int min = -1;
-    int pos = -1;
+    if (batch == NULL)
+    {
+        printf("Not enough memory for the batch\n");
+        return 1;
+    }
 
-    // If possible move is to move forward
-    for (i = 0; i < 4; i++)
+    for (lane = 0; lane < BATCH_LANES; lane++)
     {
-        if (posmov[i] == 'm')
-        {
-            getOpponents(temp[i], opponents, temp[i].pos + diceNum);
+        batch->isPlaying[lane] = 0;
+    }
 
-            // Prioritize token which are in range of other token
-            if (isThereOpponentsBehind(temp[i], temp[i].pos) && opponents[0].col == 'n')
+    begin = monotonicMillis();
+    do
+    {
+        // A new game starts in every empty lane at the start of a round
+        for (lane = 0; lane < BATCH_LANES; lane++)
+        {
+            if (!batch->isPlaying[lane] && started < games)
             {
-                return i;
+                batchStartGame(batch, lane, splitSeed(seed, started));
+                started++;
             }
         }
-    }
 
-    for (i = 0; i < 4; i++)
-    {
-        // Next priority any is token in the safe, and can move
-        if (temp[i].safe && posmov[i] == 'm')
+        for (colour = 0; colour < numberOfPlayers; colour++)
         {
-            return i;
+            batchTurn(batch, colour, numberOfPlayers);
         }
-    }
 
-    // Next priority on the token that's still in home base
-    for (i = 0; i < 4; i++)
-    {
-        // If possible move is to get the token out of the homebase, check if there's no one behind
-        if (posmov[i] == 'o')
+        // Games with at most one player left are over
+        isPlaying = false;
+        for (lane = 0; lane < BATCH_LANES; lane++)
         {
-            switch (playerIndex[whosTurn - 1] + 1)
+            if (!batch->isPlaying[lane])
             {
-            case 1:
-                if (!isThereOpponentsBehind(temp[i], 1))
-                {
-                    return i;
-                }
-                break;
+                continue;
+            }
 
-            case 2:
-                if (!isThereOpponentsBehind(temp[i], 14))
-                {
-                    return i;
-                }
-                break;
+            batch->turns[lane]++;
+            unfinished = numberOfPlayers - (batch->nextPlace[lane] - 1);
 
-            case 3:
-                if (!isThereOpponentsBehind(temp[i], 27))
-                {
-                    return i;
-                }
-            case 4:
-                if (!isThereOpponentsBehind(temp[i], 51))
+            if (unfinished <= 1 || batch->turns[lane] >= (uint32_t)(MAX_HEADLESS_TURN / numberOfPlayers))
+            {
+                for (colour = 0; colour < numberOfPlayers; colour++)
                 {
-                    return i;
+                    wins[1][colour] += batch->place[colour][lane] == 1;
                 }
-                break;
-
-            default:
-                break;
-            }
-        }
-    }
-
-    // If there's still no token with that criteria, move out the token which is farthest from safezone
-    for (i = 0; i < 4; i++)
-    {
-        if (posmov[i] == 'm')
-        {
-            if (i == 0)
-            {
-                // Initialize the min with the first token relpos
-                min = temp[i].relpos;
-                pos = i;
+                played[1]++;
+                batch->isPlaying[lane] = 0;
             }
-            else if (min > temp[i].relpos)
+            else
             {
-                min = temp[i].relpos;
-                pos = i;
+                isPlaying = true;
             }
         }
-    }
+    } while (isPlaying || started < games);
+    seconds[1] = (monotonicMillis() - begin) / 1000.0;
 
-    // Check if there's one found
-    if (min != -1 && pos != -1)
+    free(batch);
+
+    printf("Jorgen against himself, %d players, seed %llu\n\n", numberOfPlayers, (unsigned long long)seed);
+    printf("%-8s %9s %11s", "Engine", "Games", "Games/s");
+    for (colour = 0; colour < numberOfPlayers; colour++)
     {
-        return pos;
+        printf("  Seat %d", colour + 1);
     }
+    printf("\n");
 
-    // If there's still no possibilities, move out the first token that's possible to move
-    for (int i = 0; i < 4; i++)
+    for (i = 0; i < 2; i++)
     {
-        if (posmov[i] == 'm' || posmov[i] == 'o')
+        printf("%-8s %9ld %11.0f", i == 0 ? "scalar" : "batch", played[i], played[i] / (seconds[i] > 0 ? seconds[i] : 0.001));
+        for (colour = 0; colour < numberOfPlayers; colour++)
         {
-            return i;
+            printf(" %6.2f%%", 100.0 * wins[i][colour] / played[i]);
         }
+        printf("\n");
     }
+
+    printf("\nBatch is %.1f times faster\n",
+           (played[1] / (seconds[1] > 0 ? seconds[1] : 0.001)) / (played[0] / (seconds[0] > 0 ? seconds[0] : 0.001)));
+    return 0;
 }
 
-int calculateScore(int position)
+int calculateScore(GameContext *game, int position)
 {
-    int moves;     // Number of user moves
-    int kill;      // Number of user kill
-    int i;         // Looping
-    int baseScore; // Base score that's given to player based on winning position
+    int colour = 0; // Colour of the user
+    int i;          // Looping
 
-    // Getting the move
+    // Getting the user
     for (i = 0; i < 4; i++)
     {
-        if (!players[i].comp && players[i].col != 'n')
+        if (!game->players[i].comp && game->players[i].col != 'n')
         {
-            moves = players[i].move;
-            kill = players[i].kill;
+            colour = i;
         }
     }
 
+    return playerScore(game, colour, position);
+}
+
+int playerScore(GameContext *game, int colour, int position)
+{
+    int moves = game->players[colour].move; // Number of the player moves
+    int kill = game->players[colour].kill;  // Number of the player kill
+    int baseScore = 0;                      // Base score that's given to player based on winning position
+
     // baseScore based of how much bots and position
-    switch (numberOfBots)
+    switch (game->numberOfBots)
     {
     case 1:
         if (position == 1)
@@ -4282,6 +9648,12 @@ void showLose()
     delwin(lose);
 }
 
+void showSeed(uint64_t seed)
+{
+    mvprintw(10, getMiddleX(stdscr, strlen("Seed of the game : ") + 20), "Seed of the game : %llu", (unsigned long long)seed);
+    refresh();
+}
+
 void newHighScoreMenu(int score)
 {
     WINDOW *menu;  // The high score menu